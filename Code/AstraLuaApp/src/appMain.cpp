@@ -3,6 +3,8 @@
 // @R Jones 2025
 
 #include <pocketmage.h>
+#include <algorithm>
+#include <new>
 #include <string>
 #include <vector>
 
@@ -20,6 +22,7 @@ static std::vector<std::string> consoleLines;
 static std::string inputLine;
 static int scrollOffset = 0;
 static volatile bool needsRedraw = true;
+static volatile bool canvasActive = false;  // a script frame is on the e-ink, not the console
 
 // Display constants
 static constexpr int MAX_CONSOLE_LINES = 200;
@@ -83,6 +86,493 @@ static int lua_pm_print(lua_State* Ls) {
   return 0;
 }
 
+// ===================== PM DRAW BUFFER =====================
+// pm.eink calls are recorded here and handed to the e-ink task by
+// pm.flush() (or when a command finishes), which draws the whole frame
+// and does one refresh for it.
+struct DrawCmd {
+  enum Op : uint8_t { CLEAR, PIXEL, LINE, RECT, FILL_RECT, CIRCLE, FILL_CIRCLE, TEXT, FONT };
+  uint8_t  op;
+  uint16_t color;
+  int16_t  a, b, c, d;     // x/y/w/h, x0/y0/x1/y1, x/y/r, or font index in a
+  uint32_t textOff;        // TEXT: slice of the frame's text pool
+  uint16_t textLen;
+};
+
+struct DrawFrame {
+  std::vector<DrawCmd> cmds;
+  std::string          text;
+
+  bool empty() const { return cmds.empty(); }
+  void clear()       { cmds.clear(); text.clear(); }
+};
+
+static constexpr size_t MAX_DRAW_CMDS = 2048;
+
+static DrawFrame pendingFrame;  // being recorded by Lua (loop task)
+static DrawFrame readyFrame;    // flushed, waiting for the e-ink task
+static DrawFrame drawingFrame;  // owned by the e-ink task
+static SemaphoreHandle_t frameLock = nullptr;
+static bool oledDirty = false;
+
+static const GFXfont* const LUA_FONTS[] = {
+  &FreeMono9pt7b, &FreeMonoBold9pt7b, &FreeSans9pt7b, &FreeSerif9pt7b, &FreeMono12pt7b, &Font5x7Fixed,
+};
+static const char* const LUA_FONT_NAMES[] = { "mono", "monobold", "sans", "serif", "mono12", "small", nullptr };
+
+static void flushFrame() {
+  if (oledDirty) {
+    u8g2.sendBuffer();
+    oledDirty = false;
+  }
+  if (pendingFrame.empty()) return;
+
+  xSemaphoreTake(frameLock, portMAX_DELAY);
+  if (readyFrame.empty()) {
+    std::swap(readyFrame, pendingFrame);
+  } else {
+    // Previous frame not drawn yet: draw both with the same refresh
+    const uint32_t base = readyFrame.text.size();
+    for (DrawCmd cmd : pendingFrame.cmds) {
+      cmd.textOff += base;
+      readyFrame.cmds.push_back(cmd);
+    }
+    readyFrame.text += pendingFrame.text;
+  }
+  canvasActive = true;
+  xSemaphoreGive(frameLock);
+  pendingFrame.clear();
+}
+
+// Screen area touched by a frame, in the console's rotation
+struct DirtyRect {
+  int16_t x0 = INT16_MAX, y0 = INT16_MAX, x1 = INT16_MIN, y1 = INT16_MIN;  // inclusive
+
+  void add(int x, int y, int w, int h) {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    if (w == 0 || h == 0) return;
+    x0 = std::min<int>(x0, x);         y0 = std::min<int>(y0, y);
+    x1 = std::max<int>(x1, x + w - 1); y1 = std::max<int>(y1, y + h - 1);
+  }
+  // Clip to the screen; false if nothing is left
+  bool clip(int16_t w, int16_t h) {
+    x0 = std::max<int16_t>(x0, 0);     y0 = std::max<int16_t>(y0, 0);
+    x1 = std::min<int16_t>(x1, w - 1); y1 = std::min<int16_t>(y1, h - 1);
+    return x0 <= x1 && y0 <= y1;
+  }
+};
+
+// Draws into the full-window buffer, which keeps the script's canvas
+// between frames, and returns the area the frame touched
+static DirtyRect renderFrame(const DrawFrame& frame) {
+  DirtyRect dirty;
+  display.setRotation(3);
+  display.setFont(&FreeMono9pt7b);
+  for (const DrawCmd& cmd : frame.cmds) {
+    switch (cmd.op) {
+      case DrawCmd::CLEAR:
+        display.fillScreen(cmd.color);
+        dirty.add(0, 0, display.width(), display.height());
+        break;
+      case DrawCmd::PIXEL:
+        display.drawPixel(cmd.a, cmd.b, cmd.color);
+        dirty.add(cmd.a, cmd.b, 1, 1);
+        break;
+      case DrawCmd::LINE:
+        display.drawLine(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);
+        dirty.add(std::min(cmd.a, cmd.c), std::min(cmd.b, cmd.d),
+                  abs(cmd.c - cmd.a) + 1, abs(cmd.d - cmd.b) + 1);
+        break;
+      case DrawCmd::RECT:
+        display.drawRect(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);
+        dirty.add(cmd.a, cmd.b, cmd.c, cmd.d);
+        break;
+      case DrawCmd::FILL_RECT:
+        display.fillRect(cmd.a, cmd.b, cmd.c, cmd.d, cmd.color);
+        dirty.add(cmd.a, cmd.b, cmd.c, cmd.d);
+        break;
+      case DrawCmd::CIRCLE:
+        display.drawCircle(cmd.a, cmd.b, cmd.c, cmd.color);
+        dirty.add(cmd.a - cmd.c, cmd.b - cmd.c, 2 * cmd.c + 1, 2 * cmd.c + 1);
+        break;
+      case DrawCmd::FILL_CIRCLE:
+        display.fillCircle(cmd.a, cmd.b, cmd.c, cmd.color);
+        dirty.add(cmd.a - cmd.c, cmd.b - cmd.c, 2 * cmd.c + 1, 2 * cmd.c + 1);
+        break;
+      case DrawCmd::FONT:
+        display.setFont(LUA_FONTS[cmd.a]);
+        break;
+      case DrawCmd::TEXT: {
+        const String text = String(frame.text.substr(cmd.textOff, cmd.textLen).c_str());
+        int16_t bx, by;
+        uint16_t bw, bh;
+        display.getTextBounds(text, cmd.a, cmd.b, &bx, &by, &bw, &bh);
+        dirty.add(bx, by, bw, bh);
+        display.setTextColor(cmd.color);
+        display.setCursor(cmd.a, cmd.b);
+        display.print(text);
+        break;
+      }
+    }
+  }
+  return dirty;
+}
+
+// ===================== PM MODULE: E-INK =====================
+// Colors: true/1 (default) is black, false/0 is white
+static uint16_t optColor(lua_State* Ls, int arg) {
+  if (lua_isnoneornil(Ls, arg)) return GxEPD_BLACK;
+  const bool black = lua_isboolean(Ls, arg) ? lua_toboolean(Ls, arg) : luaL_checkinteger(Ls, arg) != 0;
+  return black ? GxEPD_BLACK : GxEPD_WHITE;
+}
+
+// Coordinates are arguments 1..nargs, the color is colorArg (0 = none)
+static DrawCmd& pushCmd(lua_State* Ls, uint8_t op, int nargs, int colorArg) {
+  if (pendingFrame.cmds.size() >= MAX_DRAW_CMDS) {
+    luaL_error(Ls, "draw buffer full, call pm.flush()");
+  }
+  DrawCmd cmd = {};
+  cmd.op = op;
+  int16_t* args[4] = { &cmd.a, &cmd.b, &cmd.c, &cmd.d };
+  for (int i = 0; i < nargs; i++) *args[i] = (int16_t)luaL_checkinteger(Ls, i + 1);
+  if (colorArg > 0) cmd.color = optColor(Ls, colorArg);
+  pendingFrame.cmds.push_back(cmd);
+  return pendingFrame.cmds.back();
+}
+
+static int lua_eink_clear(lua_State* Ls) {
+  // Clear defaults to white
+  DrawCmd& cmd = pushCmd(Ls, DrawCmd::CLEAR, 0, 1);
+  if (lua_isnoneornil(Ls, 1)) cmd.color = GxEPD_WHITE;
+  return 0;
+}
+static int lua_eink_pixel(lua_State* Ls)      { pushCmd(Ls, DrawCmd::PIXEL, 2, 3);        return 0; }
+static int lua_eink_line(lua_State* Ls)       { pushCmd(Ls, DrawCmd::LINE, 4, 5);         return 0; }
+static int lua_eink_rect(lua_State* Ls)       { pushCmd(Ls, DrawCmd::RECT, 4, 5);         return 0; }
+static int lua_eink_fill(lua_State* Ls)       { pushCmd(Ls, DrawCmd::FILL_RECT, 4, 5);    return 0; }
+static int lua_eink_circle(lua_State* Ls)     { pushCmd(Ls, DrawCmd::CIRCLE, 3, 4);       return 0; }
+static int lua_eink_fillCircle(lua_State* Ls) { pushCmd(Ls, DrawCmd::FILL_CIRCLE, 3, 4);  return 0; }
+
+static int lua_eink_text(lua_State* Ls) {
+  size_t len;
+  const char* s = luaL_checklstring(Ls, 3, &len);
+  DrawCmd& cmd = pushCmd(Ls, DrawCmd::TEXT, 2, 4);
+  cmd.textOff = pendingFrame.text.size();
+  cmd.textLen = (uint16_t)std::min<size_t>(len, UINT16_MAX);
+  pendingFrame.text.append(s, cmd.textLen);
+  return 0;
+}
+
+static int lua_eink_font(lua_State* Ls) {
+  const int idx = luaL_checkoption(Ls, 1, nullptr, LUA_FONT_NAMES);
+  pushCmd(Ls, DrawCmd::FONT, 0, 0).a = (int16_t)idx;
+  return 0;
+}
+
+static const luaL_Reg pmEinkFuncs[] = {
+  { "clear",      lua_eink_clear },
+  { "pixel",      lua_eink_pixel },
+  { "line",       lua_eink_line },
+  { "rect",       lua_eink_rect },
+  { "fill",       lua_eink_fill },
+  { "circle",     lua_eink_circle },
+  { "fillCircle", lua_eink_fillCircle },
+  { "text",       lua_eink_text },
+  { "font",       lua_eink_font },
+  { nullptr, nullptr }
+};
+
+// ===================== PM MODULE: OLED =====================
+// Draws into the U8g2 buffer; sent on pm.oled.show() or pm.flush()
+static int lua_oled_clear(lua_State* Ls) {
+  u8g2.clearBuffer();
+  oledDirty = true;
+  return 0;
+}
+
+static int lua_oled_text(lua_State* Ls) {
+  u8g2.drawStr(luaL_checkinteger(Ls, 1), luaL_checkinteger(Ls, 2), luaL_checkstring(Ls, 3));
+  oledDirty = true;
+  return 0;
+}
+
+static int lua_oled_line(lua_State* Ls) {
+  u8g2.drawLine(luaL_checkinteger(Ls, 1), luaL_checkinteger(Ls, 2),
+                luaL_checkinteger(Ls, 3), luaL_checkinteger(Ls, 4));
+  oledDirty = true;
+  return 0;
+}
+
+static int lua_oled_box(lua_State* Ls) {
+  const int x = luaL_checkinteger(Ls, 1), y = luaL_checkinteger(Ls, 2);
+  const int w = luaL_checkinteger(Ls, 3), h = luaL_checkinteger(Ls, 4);
+  if (lua_toboolean(Ls, 5)) u8g2.drawBox(x, y, w, h);
+  else                      u8g2.drawFrame(x, y, w, h);
+  oledDirty = true;
+  return 0;
+}
+
+static int lua_oled_show(lua_State* Ls) {
+  u8g2.sendBuffer();
+  oledDirty = false;
+  return 0;
+}
+
+static const luaL_Reg pmOledFuncs[] = {
+  { "clear", lua_oled_clear },
+  { "text",  lua_oled_text },
+  { "line",  lua_oled_line },
+  { "box",   lua_oled_box },
+  { "show",  lua_oled_show },
+  { nullptr, nullptr }
+};
+
+// ===================== PM MODULE: SD =====================
+static constexpr const char* LUA_FILE_MT = "pm.File";
+
+// Relative paths are under /lua
+static std::string luaPath(lua_State* Ls, int arg) {
+  const char* p = luaL_checkstring(Ls, arg);
+  return p[0] == '/' ? std::string(p) : std::string("/lua/") + p;
+}
+
+static File& checkFile(lua_State* Ls) {
+  File* f = (File*)luaL_checkudata(Ls, 1, LUA_FILE_MT);
+  if (!*f) luaL_error(Ls, "file is closed");
+  return *f;
+}
+
+static int lua_sd_open(lua_State* Ls) {
+  const std::string path = luaPath(Ls, 1);
+  const char* mode = luaL_optstring(Ls, 2, "r");
+  const char* fsMode = FILE_READ;
+  if (mode[0] == 'w')      fsMode = FILE_WRITE;
+  else if (mode[0] == 'a') fsMode = FILE_APPEND;
+  else if (mode[0] != 'r') return luaL_argerror(Ls, 2, "mode must be r, w or a");
+
+  File file = SD_MMC.open(path.c_str(), fsMode);
+  if (!file) {
+    lua_pushnil(Ls);
+    lua_pushstring(Ls, ("cannot open " + path).c_str());
+    return 2;
+  }
+  File* ud = (File*)lua_newuserdatauv(Ls, sizeof(File), 0);
+  new (ud) File(file);
+  luaL_setmetatable(Ls, LUA_FILE_MT);
+  return 1;
+}
+
+// f:read([n]) - up to n bytes (default 512), nil at end of file
+static int lua_file_read(lua_State* Ls) {
+  File& f = checkFile(Ls);
+  const size_t n = (size_t)luaL_optinteger(Ls, 2, 512);
+  luaL_Buffer b;
+  char* dst = luaL_buffinitsize(Ls, &b, n);
+  const size_t got = f.read((uint8_t*)dst, n);
+  if (got == 0 && n > 0) {
+    lua_pushnil(Ls);
+    return 1;
+  }
+  luaL_pushresultsize(&b, got);
+  return 1;
+}
+
+// f:readLine() - next line without the newline, nil at end of file
+static int lua_file_readLine(lua_State* Ls) {
+  File& f = checkFile(Ls);
+  luaL_Buffer b;
+  luaL_buffinit(Ls, &b);
+  char chunk[128];
+  bool any = false;
+  for (;;) {
+    const size_t start = f.position();
+    const size_t got = f.read((uint8_t*)chunk, sizeof(chunk));
+    if (got == 0) break;
+    any = true;
+    const char* nl = (const char*)memchr(chunk, '\n', got);
+    if (nl) {
+      size_t len = nl - chunk;
+      luaL_addlstring(&b, chunk, (len > 0 && chunk[len - 1] == '\r') ? len - 1 : len);
+      f.seek(start + (nl - chunk) + 1);
+      break;
+    }
+    luaL_addlstring(&b, chunk, got);
+  }
+  if (!any) {
+    lua_pushnil(Ls);
+    return 1;
+  }
+  luaL_pushresult(&b);
+  return 1;
+}
+
+static int lua_file_write(lua_State* Ls) {
+  File& f = checkFile(Ls);
+  size_t len;
+  const char* s = luaL_checklstring(Ls, 2, &len);
+  lua_pushinteger(Ls, f.write((const uint8_t*)s, len));
+  return 1;
+}
+
+static int lua_file_seek(lua_State* Ls) {
+  lua_pushboolean(Ls, checkFile(Ls).seek((uint32_t)luaL_checkinteger(Ls, 2)));
+  return 1;
+}
+
+static int lua_file_size(lua_State* Ls)     { lua_pushinteger(Ls, checkFile(Ls).size());     return 1; }
+static int lua_file_position(lua_State* Ls) { lua_pushinteger(Ls, checkFile(Ls).position()); return 1; }
+
+static int lua_file_close(lua_State* Ls) {
+  File* f = (File*)luaL_checkudata(Ls, 1, LUA_FILE_MT);
+  if (*f) f->close();
+  return 0;
+}
+
+static int lua_file_gc(lua_State* Ls) {
+  File* f = (File*)luaL_checkudata(Ls, 1, LUA_FILE_MT);
+  if (*f) f->close();
+  f->~File();
+  return 0;
+}
+
+static const luaL_Reg pmFileMethods[] = {
+  { "read",     lua_file_read },
+  { "readLine", lua_file_readLine },
+  { "write",    lua_file_write },
+  { "seek",     lua_file_seek },
+  { "size",     lua_file_size },
+  { "position", lua_file_position },
+  { "close",    lua_file_close },
+  { nullptr, nullptr }
+};
+
+static int lua_sd_list(lua_State* Ls) {
+  const std::string path = lua_isnoneornil(Ls, 1) ? std::string("/lua") : luaPath(Ls, 1);
+  File dir = SD_MMC.open(path.c_str());
+  lua_newtable(Ls);
+  if (!dir || !dir.isDirectory()) return 1;
+
+  int i = 1;
+  for (File entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+    const char* name = entry.name();
+    const char* slash = strrchr(name, '/');
+    lua_pushstring(Ls, slash ? slash + 1 : name);
+    lua_rawseti(Ls, -2, i++);
+  }
+  dir.close();
+  return 1;
+}
+
+static int lua_sd_exists(lua_State* Ls) {
+  lua_pushboolean(Ls, SD_MMC.exists(luaPath(Ls, 1).c_str()));
+  return 1;
+}
+
+static int lua_sd_remove(lua_State* Ls) {
+  lua_pushboolean(Ls, SD_MMC.remove(luaPath(Ls, 1).c_str()));
+  return 1;
+}
+
+static const luaL_Reg pmSdFuncs[] = {
+  { "open",   lua_sd_open },
+  { "list",   lua_sd_list },
+  { "exists", lua_sd_exists },
+  { "remove", lua_sd_remove },
+  { nullptr, nullptr }
+};
+
+// ===================== PM MODULE =====================
+// Key read by the interrupt hook, handed to the next pm.key()
+static char stashedKey = 0;
+static unsigned long lastHookPoll = 0;
+
+static constexpr int HOOK_INSTRUCTIONS = 1000;
+static constexpr unsigned long HOOK_POLL_MS = 50;
+
+// Count hook: lets HOME stop scripts that never call pm.key()
+static void luaInterruptHook(lua_State* Ls, lua_Debug* ar) {
+  if (millis() - lastHookPoll < HOOK_POLL_MS) return;
+  lastHookPoll = millis();
+  if (stashedKey != 0) return;
+
+  const char c = KB().updateKeypress();
+  if (c == 12) luaL_error(Ls, "interrupted");
+  stashedKey = c;
+}
+
+// pm.key([timeoutMs]) - key code, or nil if none arrived in time.
+// HOME stops the running script.
+static int lua_pm_key(lua_State* Ls) {
+  const unsigned long timeout = (unsigned long)luaL_optinteger(Ls, 1, 0);
+  const unsigned long start = millis();
+  for (;;) {
+    char c = stashedKey;
+    stashedKey = 0;
+    if (c == 0) c = KB().updateKeypress();
+    if (c == 12) return luaL_error(Ls, "interrupted");
+    if (c != 0) {
+      lua_pushinteger(Ls, (uint8_t)c);
+      return 1;
+    }
+    if (millis() - start >= timeout) break;
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  lua_pushnil(Ls);
+  return 1;
+}
+
+static int lua_pm_flush(lua_State* Ls) {
+  flushFrame();
+  return 0;
+}
+
+static int lua_pm_delay(lua_State* Ls) {
+  vTaskDelay(pdMS_TO_TICKS(luaL_checkinteger(Ls, 1)));
+  return 0;
+}
+
+static int lua_pm_millis(lua_State* Ls) {
+  lua_pushinteger(Ls, millis());
+  return 1;
+}
+
+static const luaL_Reg pmFuncs[] = {
+  { "key",    lua_pm_key },
+  { "flush",  lua_pm_flush },
+  { "delay",  lua_pm_delay },
+  { "millis", lua_pm_millis },
+  { nullptr, nullptr }
+};
+
+static int luaopen_pm(lua_State* Ls) {
+  luaL_newmetatable(Ls, LUA_FILE_MT);
+  luaL_newlib(Ls, pmFileMethods);
+  lua_setfield(Ls, -2, "__index");
+  lua_pushcfunction(Ls, lua_file_gc);
+  lua_setfield(Ls, -2, "__gc");
+  lua_pop(Ls, 1);
+
+  luaL_newlib(Ls, pmFuncs);
+  luaL_newlib(Ls, pmEinkFuncs);
+  lua_setfield(Ls, -2, "eink");
+  luaL_newlib(Ls, pmOledFuncs);
+  lua_setfield(Ls, -2, "oled");
+  luaL_newlib(Ls, pmSdFuncs);
+  lua_setfield(Ls, -2, "sd");
+
+  // e-ink canvas size in the console's rotation
+  lua_pushinteger(Ls, 320);
+  lua_setfield(Ls, -2, "WIDTH");
+  lua_pushinteger(Ls, 240);
+  lua_setfield(Ls, -2, "HEIGHT");
+  lua_pushinteger(Ls, 13);
+  lua_setfield(Ls, -2, "KEY_ENTER");
+  lua_pushinteger(Ls, 8);
+  lua_setfield(Ls, -2, "KEY_BACKSPACE");
+  return 1;
+}
+
 // ===================== LUA INITIALIZATION =====================
 static void initLua() {
   if (L) {
@@ -97,8 +587,11 @@ static void initLua() {
   lua_pushcfunction(L, lua_pm_print);
   lua_setglobal(L, "print");
   
-  // Add PocketMage-specific functions here in the future
-  // e.g., beep(), display functions, etc.
+  // pm module: drawing, SD files and keys (global and require("pm"))
+  luaL_requiref(L, "pm", luaopen_pm, 1);
+  lua_pop(L, 1);
+  lua_sethook(L, luaInterruptHook, LUA_MASKCOUNT, HOOK_INSTRUCTIONS);
+  pendingFrame.clear();
 }
 
 // ===================== COMMAND EXECUTION =====================
@@ -107,6 +600,7 @@ static void executeCommand(const std::string& cmd) {
   if (line.empty()) return;
   
   consolePrint("> " + line);
+  canvasActive = false;
   
   // Built-in commands
   if (line == "help" || line == "?") {
@@ -124,6 +618,15 @@ static void executeCommand(const std::string& cmd) {
     consolePrint("  for i=1,5 do print(i) end");
     consolePrint("  t = {1,2,3}");
     consolePrint("  function f(x) return x*2 end");
+    consolePrint("");
+    consolePrint("pm module:");
+    consolePrint("  pm.eink.clear/pixel/line/rect/fill");
+    consolePrint("  pm.eink.circle/fillCircle/text/font");
+    consolePrint("  pm.oled.clear/text/line/box/show");
+    consolePrint("  pm.sd.open/list/exists/remove");
+    consolePrint("  pm.key([ms]) pm.flush() pm.delay(ms)");
+    consolePrint("Drawing shows on pm.flush() or when");
+    consolePrint("the command ends. HOME stops a script.");
     return;
   }
   
@@ -254,6 +757,8 @@ void appInit() {
   inputLine.clear();
   scrollOffset = 0;
   needsRedraw = true;
+  canvasActive = false;
+  if (!frameLock) frameLock = xSemaphoreCreateMutex();
   
   initLua();
   
@@ -285,6 +790,8 @@ void processKB() {
   // Enter - execute command
   if (inchar == 13) {
     executeCommand(inputLine);
+    flushFrame();
+    stashedKey = 0;  // keys typed while a script ran belong to it
     inputLine.clear();
     needsRedraw = true;
     return;
@@ -312,6 +819,7 @@ void processKB() {
     if (scrollOffset > 0) {
       scrollOffset--;
       needsRedraw = true;
+      canvasActive = false;
     }
     return;
   }
@@ -323,6 +831,7 @@ void processKB() {
     if (scrollOffset < maxScroll) {
       scrollOffset++;
       needsRedraw = true;
+      canvasActive = false;
     }
     return;
   }
@@ -348,7 +857,24 @@ void processKB() {
 
 // ===================== E-INK DISPLAY =====================
 void applicationEinkHandler() {
-  if (!needsRedraw) return;
+  if (!frameLock) return;
+
+  // A flushed script frame takes priority over the console
+  xSemaphoreTake(frameLock, portMAX_DELAY);
+  std::swap(drawingFrame, readyFrame);
+  xSemaphoreGive(frameLock);
+  if (!drawingFrame.empty()) {
+    // One partial refresh of the area the frame touched
+    DirtyRect dirty = renderFrame(drawingFrame);
+    drawingFrame.clear();
+    if (dirty.clip(display.width(), display.height())) {
+      display.displayWindow(dirty.x0, dirty.y0, dirty.x1 - dirty.x0 + 1, dirty.y1 - dirty.y0 + 1);
+      display.powerOff();
+    }
+    return;
+  }
+
+  if (!needsRedraw || canvasActive) return;
   needsRedraw = false;
   
   display.setRotation(3);
@@ -11,8 +11,18 @@
 #define TXT_APP_STYLE 1                         // 0: Old Style (NOT SUPPORTED), 1: New Style
 #define SET_CLOCK_ON_UPLOAD false               // Should system clock be set automatically on code upload?
 #define TOUCH_TIMEOUT_MS 1200                   // Delay after scrolling to return to typing mode (ms)
+#define TOUCH_SAMPLE_MS 10                      // Touch slider sample period while touched (ms)
 #define SYS_METADATA_FILE "/sys/SDMMC_META.txt" // File path to the file system metadata file
+#define SD_PROVISION_MARKER "/sys/.provisioned" // Written once the SD folder tree exists
+#define SD_LAYOUT_VERSION 1                     // Bump when setupSD provisions new folders/files
+#define COPY_BUF_SIZE 4096                      // File copy block size, multiple of the 512 B SD sector
 #define POWER_SAVE_FREQ 40                      // CPU freq for power save mode
+#define POWER_SAMPLE_MS 2000                    // Battery / charger telemetry period (ms)
+#define BATT_LOW_SHUTDOWN false                 // Save + deep sleep on the MP2722 low battery flag (not yet validated)
+#define BATT_LOW_SAMPLES 3                      // Consecutive low battery samples before that shutdown
+#define LOOP_ACTIVE_MS 50                       // Loop / E-Ink period right after input (ms)
+#define LOOP_ACTIVE_WINDOW_MS 2000              // How long the loop stays at LOOP_ACTIVE_MS after input (ms)
+#define LOOP_IDLE_MS 1000                       // Longest idle wait between loop passes (ms)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////|
 
 // PIN DEFINITION
@@ -23,6 +33,10 @@
 #define MP2722_ADDR   0x3F
 #define USB_MUX_PIN   7
 
+// The MPR121 IRQ line is not routed to the ESP32 on current boards, so the
+// slider is polled (2 status bytes per idle poll). Set the GPIO here on
+// hardware that wires it.
+#define TOUCH_IRQ     -1
 #define KB_IRQ        8
 //#define PWR_BTN       38  // V3.0
 #define PWR_BTN       0     // V3.2
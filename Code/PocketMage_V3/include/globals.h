@@ -54,7 +54,18 @@ extern const unsigned char *appIcons[11]; // App icons
 extern AppState CurrentAppState;         // Current app state
 
 // ===================== TASKS APP =====================
-extern std::vector<std::vector<String>> tasks; // Task list
+// One task, stored in /sys/tasks.txt as a fixed-width "name|YYYYMMDD|P|C"
+// line so single records can be patched in place
+#define TASK_RECORD_LEN 66                     // bytes per line, fits name|YYYYMMDD|255|1 + '\n'
+#define TASK_NAME_MAX   50                     // longest stored task name
+struct TaskRecord {
+  char     name[TASK_NAME_MAX + 1];
+  uint32_t due;        // YYYYMMDD
+  uint8_t  priority;
+  bool     completed;
+  uint16_t slot;       // line number in tasks.txt
+};
+extern std::vector<TaskRecord> tasks;          // Task list, sorted by due date
 
 // ===================== HOME APP =====================
 enum HOMEState { HOME_HOME, NOWLATER };       // Home app states
@@ -81,8 +92,10 @@ void resetIdle();
 
 // <TASKS.cpp>
 void TASKS_INIT();
-void sortTasksByDueDate(std::vector<std::vector<String>> &tasks);
+void sortTasksByDueDate(std::vector<TaskRecord> &tasks);
 void updateTaskArray();
+bool addTask(String taskName, String dueDate, String priority, String completed);  // false if tasks.txt is read-only
+bool deleteTask(int index);
 void einkHandler_TASKS();
 void processKB_TASKS();
 
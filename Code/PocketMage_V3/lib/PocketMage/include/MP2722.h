@@ -45,6 +45,7 @@ public:
   bool getBoostState(bool &enabled);
   bool getDPDMStatus(DPDMResult &out);
   bool getOTGNeed(bool &boostNeeded);
+  bool getStatusFlags(bool &batteryLow, bool &boostNeeded);  // both from one REG16 read
 
   void setUSBControlESP();
   void setUSBControlBMS();
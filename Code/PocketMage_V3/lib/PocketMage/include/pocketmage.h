@@ -6,6 +6,7 @@
 #include <pocketmage_bz.h>
 #include <pocketmage_touch.h>
 #include <pocketmage_clock.h>
+#include <pocketmage_i2c.h>
 #include <pocketmage_sys.h>
 #include <MP2722.h>
 #include <config.h>
@@ -19,9 +19,12 @@ public:
   bool begin();
   bool isValid();
 
-  void setToCompileTimeUTC() { rtc_.adjust(DateTime(F(__DATE__), F(__TIME__))); }
+  void setToCompileTimeUTC();
+  void adjust(const DateTime& dt);        // set the RTC under an I2C lease
 
-  DateTime nowDT()                                         { return rtc_.now(); }
+  DateTime nowDT();
+  DateTime cachedNow();                   // software clock, rereads the RTC once a minute
+  void resync()                                          { cacheValid_ = false; }
   RTC_PCF8563& getRTC()                                          { return rtc_; }
   long getTimeDiff()                { return timeoutMillis_ - prevTimeMillis_; }
   volatile long getTimeoutMillis() const                    { return timeoutMillis_; }
@@ -32,6 +35,11 @@ private:
   bool begun_ = false;
   volatile long timeoutMillis_ = 0;   // Timeout tracking
   volatile long prevTimeMillis_ = 0;  // Previous time for timeout
+
+  // Software clock
+  DateTime cacheBase_;
+  unsigned long cacheMillis_ = 0;
+  bool cacheValid_ = false;
 };
 
 void wireClock();
@@ -0,0 +1,95 @@
+// dP d8888b.  a88888b. //
+// 88     `88 d8'   `88 //
+// 88 .aaadP' 88        //
+// 88 88'     88        //
+// 88 88.     Y8.   .88 //
+// dP Y88888P  Y88888P' //
+
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+// Devices sharing the I2C bus (index into the stats table)
+enum I2CDevice : uint8_t {
+  I2C_DEV_KEYPAD = 0,   // TCA8418
+  I2C_DEV_TOUCH,        // MPR121
+  I2C_DEV_RTC,          // PCF8563
+  I2C_DEV_POWER,        // MP2722
+  I2C_DEV_COUNT
+};
+
+enum I2CPriority : uint8_t {
+  I2C_PRIO_HIGH = 0,    // input: keypad, touch
+  I2C_PRIO_LOW,         // telemetry, clock
+  I2C_PRIO_DEFAULT      // pick by device
+};
+
+struct I2CStats {
+  uint32_t transactions = 0;
+  uint32_t bytes        = 0;
+  uint32_t busTimeUs    = 0;
+  uint32_t coalesced    = 0;  // reads answered by an identical queued read
+};
+
+struct I2CRequest;
+
+// ===================== I2C BUS CLASS =====================
+// All bus traffic is queued to one owner task, high priority first.
+// Register reads identical to one already waiting in the queue share its
+// result. Drivers that talk to Wire themselves (RTClib, Adafruit) take an
+// exclusive lease through the same queue instead.
+class PocketmageI2C {
+public:
+  void begin();
+
+  // Queued transactions, block until done
+  bool transfer(I2CDevice dev, uint8_t addr, const uint8_t* tx, size_t txLen,
+                uint8_t* rx, size_t rxLen, I2CPriority prio = I2C_PRIO_DEFAULT);
+  bool readRegs(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t* rx, size_t len,
+                I2CPriority prio = I2C_PRIO_DEFAULT);
+  // FIFO registers pop an entry per read, so these are never coalesced
+  bool readFifo(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t* rx, size_t len,
+                I2CPriority prio = I2C_PRIO_DEFAULT);
+  bool writeReg(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t value,
+                I2CPriority prio = I2C_PRIO_DEFAULT);
+  bool probe(I2CDevice dev, uint8_t addr);
+
+  // Exclusive bus access for library drivers (prefer I2CLease)
+  void acquire(I2CDevice dev, I2CPriority prio = I2C_PRIO_DEFAULT);
+  void release();
+
+  // Accounting
+  I2CStats getStats(I2CDevice dev);
+  void     printStats();  // per second rates since the last call
+
+private:
+  portMUX_TYPE          lock_ = portMUX_INITIALIZER_UNLOCKED;
+  I2CRequest*           head_[2] = { nullptr, nullptr };  // pending, per priority
+  I2CRequest*           tail_[2] = { nullptr, nullptr };
+  TaskHandle_t          owner_ = nullptr;
+  SemaphoreHandle_t     leaseEnd_ = nullptr;
+  volatile TaskHandle_t leaseHolder_ = nullptr;
+  uint8_t               leaseDepth_ = 0;
+  I2CStats              stats_[I2C_DEV_COUNT];
+  I2CStats              printed_[I2C_DEV_COUNT];
+  unsigned long         printedAt_ = 0;
+
+  bool        submit(I2CRequest& req, I2CPriority prio);
+  I2CRequest* pop();
+  bool        execute(I2CRequest& req);
+  void        account(I2CDevice dev, uint32_t bytes, uint32_t us);
+  void        taskLoop();
+  static void taskEntry(void* arg);
+};
+
+// Scoped exclusive bus access
+class I2CLease {
+public:
+  explicit I2CLease(I2CDevice dev, I2CPriority prio = I2C_PRIO_DEFAULT);
+  ~I2CLease();
+  I2CLease(const I2CLease&) = delete;
+  I2CLease& operator=(const I2CLease&) = delete;
+};
+
+void setupI2C();
+PocketmageI2C& I2C();
@@ -24,9 +24,10 @@ public:
   // Main methods
   char updateKeypress();
   void checkUSBKB();
-  void disableInterrupts()                           { keypad_.disableInterrupts(); }
-  void enableInterrupts()                             { keypad_.enableInterrupts(); }
-  void flush()                                                   { keypad_.flush(); }
+  // Driver calls on the keypad, each under an I2C lease
+  void disableInterrupts();
+  void enableInterrupts();
+  void flush();
   void setTCA8418Event()                              {      TCA8418_event_ = true; }
 
 private:
@@ -37,6 +38,7 @@ private:
 };
 
 void wireKB();
-void setupKB(int kb_irq_pin);
+bool setupKB(int kb_irq_pin);   // no UI, safe to run from the boot task
+void reportKBFailed();
 // Interrupt handler stored in IRAM for fast interrupt response
 PocketmageKB& KB();
\ No newline at end of file
@@ -16,7 +16,17 @@
 // OLED 
 extern U8G2_SSD1326_ER_256X32_F_4W_HW_SPI u8g2;
 
+struct OledStats {
+  uint32_t framesSent    = 0;
+  uint32_t framesSkipped = 0;  // identical to what the panel already shows
+  uint32_t bytesSent     = 0;
+};
+
 // ===================== OLED CLASS =====================
+// Frames are pushed through sendBuffer(), which keeps a copy of the last
+// frame sent and writes only the changed tiles of each tile row. Code that
+// draws on u8g2 directly should send with OLED().sendBuffer() too, or call
+// invalidate() after its own u8g2.sendBuffer().
 class PocketmageOled {
 public:
   explicit PocketmageOled(U8G2 &u8) : u8g2_(u8) {}
@@ -29,11 +39,68 @@ public:
   void oledScroll();
   void infoBar();
 
+  // Frame output
+  void      sendBuffer();
+  void      invalidate()            { shadowValid_ = false; }  // next frame is sent in full
+  OledStats getStats() const        { return stats_; }
+  void      printStats();           // per second rates since the last call
+
 private:
   U8G2                  &u8g2_;        // class reference to hardware oled object
- 
+
+  // U8g2 string widths, keyed by string and font. The least used entry is
+  // replaced on a miss, so one-off strings don't push out the status labels.
+  static constexpr uint8_t WIDTH_KEY_MAX = 23;    // longer strings are measured, not cached
+  struct WidthCacheEntry {
+    uint32_t       hash;
+    const uint8_t* font;
+    uint16_t       width;
+    uint8_t        hits;
+    char           key[WIDTH_KEY_MAX + 1];
+  };
+  static constexpr uint8_t WIDTH_CACHE_SIZE = 16;
+  WidthCacheEntry       widthCache_[WIDTH_CACHE_SIZE] = {};
+
+  // oledWord font cascade and fit cache
+  struct OledWordFont {
+    const uint8_t* font;
+    uint8_t        yOffset;
+  };
+  static constexpr uint8_t OLED_WORD_FONT_COUNT = 5;
+  static const OledWordFont OLED_WORD_FONTS[OLED_WORD_FONT_COUNT];
+  uint8_t               fontMaxAdvance_[OLED_WORD_FONT_COUNT] = {};
+
+  struct FitCacheEntry {
+    uint32_t hash;
+    uint16_t len;
+    uint16_t avail;
+    uint16_t width;
+    uint8_t  fontIdx;
+    uint8_t  start;
+    bool     valid;
+  };
+  static constexpr uint8_t FIT_CACHE_SIZE = 8;
+  FitCacheEntry         fitCache_[FIT_CACHE_SIZE] = {};
+  uint8_t               fitCacheNext_ = 0;
+
+  // Status bar clock text, rebuilt when the minute changes
+  uint32_t              clockMinute_ = 0;
+  char                  timeStr_[8]  = "";
+  char                  dateStr_[16] = "";
+
+  // Last frame sent, in U8g2 buffer layout (tile rows of 8 px)
+  static constexpr uint16_t SHADOW_SIZE = 256 * 32 / 8;
+  uint8_t               shadow_[SHADOW_SIZE];
+  bool                  shadowValid_ = false;
+  OledStats             stats_;
+  OledStats             printed_;
+  unsigned long         printedAt_ = 0;
+
   // helpers
   uint16_t strWidth(const String& s) const;
+  uint16_t u8g2Width(const char* s);
+  uint8_t  fitWordFont(const char* s, uint8_t start, uint16_t& width);
+  void     updateClockStrings();
 };
 
 void setupOled();
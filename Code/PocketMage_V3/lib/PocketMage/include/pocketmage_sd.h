@@ -55,4 +55,7 @@ private:
 };
 
 void setupSD();
+bool mountSD();
+void reportNoSD();
+void provisionSD();
 PocketmageSD& SD();
@@ -10,6 +10,8 @@
 #pragma once
 #include <Arduino.h>
 #include <vector>
+#include <config.h>
+#include <freertos/event_groups.h>
 
 class String;
 
@@ -25,12 +27,16 @@ namespace pocketmage{
   namespace file{
     void saveFile();
     void writeMetadata(const String& path);
+    void writeMetadata(const String& path, size_t fileSizeBytes, int charCount);
     void loadFile(bool showOLED = true);
     void delFile(String fileName);
     void deleteMetadata(String path);
     void renFile(String oldFile, String newFile);
     void renMetadata(String oldPath, String newPath);
-    void copyFile(String oldFile, String newFile);
+    // Called after each copied block with bytes done / total
+    typedef void (*CopyProgress)(size_t copied, size_t total);
+    bool copyFile(String oldFile, String newFile, bool verify = false,
+                  CopyProgress progress = nullptr);
     void appendToFile(String path, String inText);
   }
 
@@ -40,8 +46,40 @@ namespace pocketmage{
     void setCpuSpeed(int newFreq);
   }
   namespace power{
+    // Latest battery / charger sample, published by the power service
+    struct PowerSnapshot {
+      float    voltage    = 0.0f;   // filtered battery voltage (V)
+      uint8_t  percent    = 0;      // estimated state of charge (%)
+      int      battState  = 0;      // 0-4 charge level, 5 = charging
+      uint8_t  chargeCode = 0;      // MP2722 charge status code
+      bool     charging   = false;
+      bool     batteryLow = false;
+      bool     otgNeeded  = false;  // USB device attached, boost requested
+      uint32_t sampledAt  = 0;      // millis() of the sample
+    };
+
+    // Event group bits, set on change and cleared by takePowerEvents()
+    enum PowerEvent : uint32_t {
+      POWER_EVT_BATT   = 1 << 0,
+      POWER_EVT_CHARGE = 1 << 1,
+      POWER_EVT_OTG    = 1 << 2,
+      POWER_EVT_LOW    = 1 << 3,
+    };
+
     void deepSleep(bool alternateScreenSaver = false);
     void IRAM_ATTR PWR_BTN_irq();
+    void startPowerService(uint32_t periodMs = POWER_SAMPLE_MS);
+    PowerSnapshot getPowerSnapshot();
+    EventGroupHandle_t powerEvents();
+    uint32_t takePowerEvents(uint32_t mask);
+
+    // Loop / E-Ink wakeups (input, timers and services call wakeLoop)
+    void wakeLoop();
+    void IRAM_ATTR wakeLoopFromISR();
+    void waitForLoopWork();
+    void waitForEinkWork();
+    void configureLightSleep();
+    void printSleepStats();
     void updateBattState();
     void loadState(bool changeState = true);
   }
@@ -9,6 +9,11 @@ class PocketmageEink;
 extern Adafruit_MPR121 cap; // Touch slider
 
 // ===================== CAPACATIVE TOUCH CLASS =====================
+// Slider sampling runs in its own task, woken by the MPR121 IRQ. While a
+// finger is down it reads electrode deltas at TOUCH_SAMPLE_MS, tracks a
+// centroid position and velocity, and queues whole-pad scroll steps.
+// After release the velocity keeps producing steps until friction stops it.
+// updateScrollFromTouch()/updateScroll() just drain the queued steps.
 class PocketmageTOUCH {
 public:
   explicit PocketmageTOUCH(Adafruit_MPR121 &cap) : cap_(cap) {}
@@ -23,13 +28,33 @@ public:
   long int getPrevDynamicScroll() const { return prev_dynamicScroll_; }
   int getLastTouch() const { return lastTouch_; }
   int getDiff() const { return dynamicScroll_ - prev_dynamicScroll_; }
+
+  // touch task
+  void startTask(int irqPin);
+  void notifyFromISR();
 private:
   Adafruit_MPR121      &cap_;                          // class reference to hardware touch object
   volatile long int dynamicScroll_ = 0;         // Dynamic scroll offset
   volatile long int prev_dynamicScroll_ = 0;    // Previous scroll offset
   int lastTouch_ = -1;                          // Last touch event
   unsigned long lastTouchTime_ = 0;             // Last touch time
+
+  // shared with the touch task
+  portMUX_TYPE          lock_ = portMUX_INITIALIZER_UNLOCKED;
+  int32_t               pendingSteps_ = 0;      // queued scroll steps (+ = toward higher pads)
+  int                   touchedPad_ = -1;       // pad under the finger since last take, -1 if none
+  bool                  moving_ = false;        // finger down or coasting
+  unsigned long         lastActivity_ = 0;      // millis() of last touch or coast step
+  TaskHandle_t          taskHandle_ = nullptr;
+  bool                  irqWired_ = false;
+
+  int32_t takeSteps(bool& moving, int& pad, unsigned long& lastActivity);
+  void    pushSteps(int32_t steps, int pad);
+  bool    readSlider(float& pos);
+  void    taskLoop();
+  static void taskEntry(void* arg);
 };
 
-void setupTouch();
+bool setupTouch();              // no UI, safe to run from the boot task
+void reportTouchFailed();
 PocketmageTOUCH& TOUCH();
\ No newline at end of file
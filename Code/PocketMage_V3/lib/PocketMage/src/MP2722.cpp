@@ -19,25 +19,15 @@ bool MP2722::begin() {
 }
 
 bool MP2722::isConnected() {
-  _wire->beginTransmission(MP2722_ADDR);
-  return (_wire->endTransmission() == 0);
+  return I2C().probe(I2C_DEV_POWER, MP2722_ADDR);
 }
 
 bool MP2722::writeReg(uint8_t reg, uint8_t value) {
-  _wire->beginTransmission(MP2722_ADDR);
-  _wire->write(reg);
-  _wire->write(value);
-  return (_wire->endTransmission() == 0);
+  return I2C().writeReg(I2C_DEV_POWER, MP2722_ADDR, reg, value);
 }
 
 bool MP2722::readReg(uint8_t reg, uint8_t &value) {
-  _wire->beginTransmission(MP2722_ADDR);
-  _wire->write(reg);
-  if (_wire->endTransmission(false) != 0) return false;
-
-  if (_wire->requestFrom(static_cast<uint8_t>(MP2722_ADDR), static_cast<uint8_t>(1)) != 1) return false;
-  value = _wire->read();
-  return true;
+  return I2C().readRegs(I2C_DEV_POWER, MP2722_ADDR, reg, &value, 1);
 }
 
 bool MP2722::setCCMode(uint8_t cc_cfg) {
@@ -186,6 +176,15 @@ bool MP2722::getOTGNeed(bool &boostNeeded) {
     return true;
 }
 
+bool MP2722::getStatusFlags(bool &batteryLow, bool &boostNeeded) {
+    uint8_t reg;
+    if (!readReg(MP2722_REG16, reg)) return false; // I2C fail
+
+    batteryLow  = (reg >> 4) & 0x01;
+    boostNeeded = (reg & (1 << 3)) != 0;
+    return true;
+}
+
 void MP2722::printDiagnostics() {
     Serial.println(F("=== MP2722 Diagnostics ==="));
 
@@ -27,10 +27,16 @@ void PocketmageBZ::end() {
 }
 
 // Setup for Buzzer Class
+// The startup jingle plays from its own task so boot is not held up by it
+static void startupJingleTask(void* parameter) {
+  BZ().playJingle(Jingles::Startup);
+  vTaskDelete(NULL);
+}
+
 void setupBZ() {
   auto& bz = BZ();
   bz.begin();
-  bz.playJingle(Jingles::Startup);
+  xTaskCreate(startupJingleTask, "jingleTask", 2048, NULL, 1, NULL);
 }
 
 // Access for other apps
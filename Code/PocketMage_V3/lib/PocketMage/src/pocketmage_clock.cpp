@@ -9,6 +9,9 @@
 
 static constexpr const char* tag = "CLOCK";
 
+// How often the software clock rereads the RTC over I2C
+static constexpr unsigned long CLOCK_RESYNC_MS = 60000;
+
 RTC_PCF8563 rtc;
 
 const char daysOfTheWeek[7][12] = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday" };
@@ -18,6 +21,7 @@ static PocketmageCLOCK pm_clock(rtc);
 
 // Setup for Clock Class
 void setupClock(){
+  I2CLease bus(I2C_DEV_RTC);
   pinMode(RTC_INT, INPUT);
   if (!CLOCK().begin()) {
     ESP_LOGE(tag, "Couldn't find RTC");
@@ -41,15 +45,46 @@ void wireClock(){
 PocketmageCLOCK& CLOCK() { return pm_clock; }
 
 bool PocketmageCLOCK::begin() {
+  I2CLease bus(I2C_DEV_RTC);
   if (!rtc_.begin()) { begun_ = false; return false; }
   begun_ = true;
   return true;
 }
 
+void PocketmageCLOCK::setToCompileTimeUTC() {
+  I2CLease bus(I2C_DEV_RTC);
+  rtc_.adjust(DateTime(F(__DATE__), F(__TIME__)));
+  resync();
+}
+
+void PocketmageCLOCK::adjust(const DateTime& dt) {
+  I2CLease bus(I2C_DEV_RTC);
+  rtc_.adjust(dt);
+  resync();
+}
+
+DateTime PocketmageCLOCK::nowDT() {
+  I2CLease bus(I2C_DEV_RTC);
+  return rtc_.now();
+}
+
 bool PocketmageCLOCK::isValid() {
   if (!begun_) return false;
-  DateTime t = rtc_.now();
+  DateTime t = nowDT();
   const bool saneYear = t.year() >= 2020 && t.year() < 2099;  // check for reasonable year for DateTime t
   return saneYear;
 }
 
+// Time for UI that redraws often (OLED status bar). Advances the last RTC
+// reading with millis() so most calls stay off the I2C bus.
+DateTime PocketmageCLOCK::cachedNow() {
+  const unsigned long now = millis();
+  if (!cacheValid_ || now - cacheMillis_ >= CLOCK_RESYNC_MS) {
+    cacheBase_ = nowDT();
+    cacheMillis_ = now;
+    cacheValid_ = true;
+    return cacheBase_;
+  }
+  return cacheBase_ + TimeSpan((int32_t)((now - cacheMillis_) / 1000));
+}
+
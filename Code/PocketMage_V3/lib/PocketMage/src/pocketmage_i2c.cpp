@@ -0,0 +1,275 @@
+// dP d8888b.  a88888b. //
+// 88     `88 d8'   `88 //
+// 88 .aaadP' 88        //
+// 88 88'     88        //
+// 88 88.     Y8.   .88 //
+// dP Y88888P  Y88888P' //
+
+#include <pocketmage.h>
+#include <esp_timer.h>
+
+static constexpr const char* TAG = "I2C";
+
+static const char* const DEVICE_NAMES[I2C_DEV_COUNT] = { "KB", "TOUCH", "RTC", "PWR" };
+
+struct I2CRequest {
+  enum Kind : uint8_t { TRANSFER, LEASE };
+
+  Kind              kind        = TRANSFER;
+  I2CDevice         dev         = I2C_DEV_KEYPAD;
+  uint8_t           addr        = 0;
+  const uint8_t*    tx          = nullptr;
+  size_t            txLen       = 0;
+  uint8_t*          rx          = nullptr;
+  size_t            rxLen       = 0;
+  bool              coalescable = false;
+  bool              ok          = false;
+  TaskHandle_t      waiter      = nullptr;
+  I2CRequest*       next        = nullptr;   // pending list
+  I2CRequest*       followers   = nullptr;   // coalesced duplicates
+  StaticSemaphore_t doneBuf;
+  SemaphoreHandle_t done        = nullptr;
+
+  I2CRequest()  { done = xSemaphoreCreateBinaryStatic(&doneBuf); }
+  ~I2CRequest() { vSemaphoreDelete(done); }
+};
+
+// Initialization of I2C class
+static PocketmageI2C pm_i2c;
+
+// Setup for I2C Class (after Wire.begin)
+void setupI2C() {
+  I2C().begin();
+}
+
+// Access for other apps
+PocketmageI2C& I2C() { return pm_i2c; }
+
+static I2CPriority resolvePriority(I2CDevice dev, I2CPriority prio) {
+  if (prio != I2C_PRIO_DEFAULT) return prio;
+  return (dev == I2C_DEV_KEYPAD || dev == I2C_DEV_TOUCH) ? I2C_PRIO_HIGH : I2C_PRIO_LOW;
+}
+
+// ===================== public functions =====================
+void PocketmageI2C::begin() {
+  if (owner_) return;
+  leaseEnd_ = xSemaphoreCreateBinary();
+
+  xTaskCreatePinnedToCore(
+    taskEntry,               // Function name
+    "i2cBusTask",            // Task name
+    3072,                    // Stack size
+    this,                    // Parameters
+    4,                       // Priority
+    &owner_,                 // Task handle
+    0                        // Core ID
+  );
+}
+
+bool PocketmageI2C::transfer(I2CDevice dev, uint8_t addr, const uint8_t* tx, size_t txLen,
+                             uint8_t* rx, size_t rxLen, I2CPriority prio) {
+  I2CRequest req;
+  req.dev   = dev;
+  req.addr  = addr;
+  req.tx    = tx;
+  req.txLen = txLen;
+  req.rx    = rx;
+  req.rxLen = rxLen;
+  req.coalescable = (rxLen > 0);
+  return submit(req, prio) && req.ok;
+}
+
+bool PocketmageI2C::readRegs(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t* rx, size_t len,
+                             I2CPriority prio) {
+  return transfer(dev, addr, &reg, 1, rx, len, prio);
+}
+
+bool PocketmageI2C::readFifo(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t* rx, size_t len,
+                             I2CPriority prio) {
+  I2CRequest req;
+  req.dev   = dev;
+  req.addr  = addr;
+  req.tx    = &reg;
+  req.txLen = 1;
+  req.rx    = rx;
+  req.rxLen = len;
+  return submit(req, prio) && req.ok;
+}
+
+bool PocketmageI2C::writeReg(I2CDevice dev, uint8_t addr, uint8_t reg, uint8_t value,
+                             I2CPriority prio) {
+  const uint8_t buf[2] = { reg, value };
+  return transfer(dev, addr, buf, 2, nullptr, 0, prio);
+}
+
+bool PocketmageI2C::probe(I2CDevice dev, uint8_t addr) {
+  return transfer(dev, addr, nullptr, 0, nullptr, 0);
+}
+
+void PocketmageI2C::acquire(I2CDevice dev, I2CPriority prio) {
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  if (!owner_ || self == owner_) return;
+  if (leaseHolder_ == self) { leaseDepth_++; return; }
+
+  I2CRequest req;
+  req.kind = I2CRequest::LEASE;
+  req.dev  = dev;
+  submit(req, prio);
+  leaseDepth_ = 1;
+}
+
+void PocketmageI2C::release() {
+  if (!owner_ || leaseHolder_ != xTaskGetCurrentTaskHandle()) return;
+  if (--leaseDepth_ > 0) return;
+  leaseHolder_ = nullptr;
+  xSemaphoreGive(leaseEnd_);
+}
+
+I2CStats PocketmageI2C::getStats(I2CDevice dev) {
+  portENTER_CRITICAL(&lock_);
+  I2CStats s = stats_[dev];
+  portEXIT_CRITICAL(&lock_);
+  return s;
+}
+
+void PocketmageI2C::printStats() {
+  const unsigned long now = millis();
+  const unsigned long elapsed = now - printedAt_;
+  if (elapsed == 0) return;
+
+  for (uint8_t d = 0; d < I2C_DEV_COUNT; d++) {
+    const I2CStats s = getStats((I2CDevice)d);
+    const I2CStats& p = printed_[d];
+    ESP_LOGD(TAG, "%s: %lu tx/s, %lu B/s, %lu us/s bus, %lu coalesced",
+             DEVICE_NAMES[d],
+             (unsigned long)((s.transactions - p.transactions) * 1000UL / elapsed),
+             (unsigned long)((s.bytes - p.bytes) * 1000UL / elapsed),
+             (unsigned long)((uint64_t)(s.busTimeUs - p.busTimeUs) * 1000UL / elapsed),
+             (unsigned long)(s.coalesced - p.coalesced));
+    printed_[d] = s;
+  }
+  printedAt_ = now;
+}
+
+// ===================== private functions =====================
+static bool sameRead(const I2CRequest& a, const I2CRequest& b) {
+  return a.kind == I2CRequest::TRANSFER && a.coalescable &&
+         a.addr == b.addr && a.rxLen == b.rxLen && a.txLen == b.txLen &&
+         memcmp(a.tx, b.tx, a.txLen) == 0;
+}
+
+// Queue a request and wait for the owner task to finish it. Runs inline
+// before the task exists, on the owner task itself, or under a lease.
+bool PocketmageI2C::submit(I2CRequest& req, I2CPriority prio) {
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  if (!owner_ || self == owner_ || (leaseHolder_ == self && req.kind == I2CRequest::TRANSFER)) {
+    if (req.kind == I2CRequest::TRANSFER) execute(req);
+    else req.ok = true;
+    return true;
+  }
+
+  req.waiter = self;
+  const uint8_t level = resolvePriority(req.dev, prio);
+
+  portENTER_CRITICAL(&lock_);
+  I2CRequest* match = nullptr;
+  if (req.coalescable) {
+    for (uint8_t l = 0; l < 2 && !match; l++)
+      for (I2CRequest* r = head_[l]; r; r = r->next)
+        if (sameRead(*r, req)) { match = r; break; }
+  }
+  if (match) {
+    req.next = match->followers;
+    match->followers = &req;
+    stats_[req.dev].coalesced++;
+  } else {
+    if (tail_[level]) tail_[level]->next = &req;
+    else              head_[level] = &req;
+    tail_[level] = &req;
+  }
+  portEXIT_CRITICAL(&lock_);
+
+  if (!match) xTaskNotifyGive(owner_);
+  xSemaphoreTake(req.done, portMAX_DELAY);
+  return true;
+}
+
+I2CRequest* PocketmageI2C::pop() {
+  portENTER_CRITICAL(&lock_);
+  I2CRequest* r = nullptr;
+  for (uint8_t l = 0; l < 2 && !r; l++) {
+    r = head_[l];
+    if (r) {
+      head_[l] = r->next;
+      if (!head_[l]) tail_[l] = nullptr;
+      r->next = nullptr;
+    }
+  }
+  portEXIT_CRITICAL(&lock_);
+  return r;
+}
+
+bool PocketmageI2C::execute(I2CRequest& req) {
+  const int64_t start = esp_timer_get_time();
+  bool ok = true;
+
+  if (req.txLen > 0 || req.rxLen == 0) {
+    Wire.beginTransmission(req.addr);
+    if (req.txLen > 0) Wire.write(req.tx, req.txLen);
+    ok = (Wire.endTransmission(req.rxLen == 0) == 0);
+  }
+  if (ok && req.rxLen > 0) {
+    ok = (Wire.requestFrom((uint16_t)req.addr, req.rxLen, true) == req.rxLen);
+    for (size_t i = 0; i < req.rxLen; i++) req.rx[i] = ok ? Wire.read() : 0;
+  }
+
+  req.ok = ok;
+  account(req.dev, req.txLen + req.rxLen, (uint32_t)(esp_timer_get_time() - start));
+  return ok;
+}
+
+void PocketmageI2C::account(I2CDevice dev, uint32_t bytes, uint32_t us) {
+  portENTER_CRITICAL(&lock_);
+  stats_[dev].transactions++;
+  stats_[dev].bytes     += bytes;
+  stats_[dev].busTimeUs += us;
+  portEXIT_CRITICAL(&lock_);
+}
+
+void PocketmageI2C::taskEntry(void* arg) {
+  static_cast<PocketmageI2C*>(arg)->taskLoop();
+}
+
+void PocketmageI2C::taskLoop() {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (I2CRequest* req = pop()) {
+      if (req->kind == I2CRequest::LEASE) {
+        // Hand the bus to the caller and wait for it to come back
+        const int64_t start = esp_timer_get_time();
+        leaseHolder_ = req->waiter;
+        req->ok = true;
+        xSemaphoreGive(req->done);
+        xSemaphoreTake(leaseEnd_, portMAX_DELAY);
+        account(req->dev, 0, (uint32_t)(esp_timer_get_time() - start));
+        continue;
+      }
+
+      execute(*req);
+      I2CRequest* f = req->followers;
+      while (f) {
+        I2CRequest* nextF = f->next;
+        memcpy(f->rx, req->rx, req->rxLen);
+        f->ok = req->ok;
+        xSemaphoreGive(f->done);
+        f = nextF;
+      }
+      xSemaphoreGive(req->done);
+    }
+  }
+}
+
+// ===================== I2CLease =====================
+I2CLease::I2CLease(I2CDevice dev, I2CPriority prio) { I2C().acquire(dev, prio); }
+I2CLease::~I2CLease()                               { I2C().release(); }
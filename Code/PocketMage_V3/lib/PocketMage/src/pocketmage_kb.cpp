@@ -35,6 +35,7 @@ void push_USB_char(char c) {
     for (int i = 0; i < MAX_USB_KB_CHARS; i++) {
         if (usb_kb_chars[i] == '\0') {  // '\0' means unused
             usb_kb_chars[i] = c;
+            pocketmage::power::wakeLoop();
             return;  // stop after adding one char
         }
     }
@@ -688,21 +689,45 @@ Adafruit_TCA8418 keypad;
 // Initialization of kb class
 static PocketmageKB pm_kb(keypad);
 
-void IRAM_ATTR KB_irq_handler() { KB().setTCA8418Event(); }
+void IRAM_ATTR KB_irq_handler() {
+  KB().setTCA8418Event();
+  pocketmage::power::wakeLoopFromISR();
+}
 
-// Setup for keyboard class
-void setupKB(int KB_irq_pin) {
+// Setup for keyboard class (failure is reported from the main task)
+bool setupKB(int KB_irq_pin) {
+  I2CLease bus(I2C_DEV_KEYPAD);
   if (!keypad.begin(TCA8418_DEFAULT_ADDR, &Wire)) {
     ESP_LOGE(TAG, "Error Initializing the Keyboard");
-    OLED().oledWord("Keyboard INIT Failed");
-    delay(1000);
-    while (1);
+    return false;
   }
   keypad.matrix(4, 10);
   wireKB();
   attachInterrupt(digitalPinToInterrupt(KB_irq_pin), KB_irq_handler, FALLING);
   keypad.flush();
   keypad.enableInterrupts();
+  return true;
+}
+
+void reportKBFailed() {
+  OLED().oledWord("Keyboard INIT Failed");
+  delay(1000);
+  while (1);
+}
+
+void PocketmageKB::disableInterrupts() {
+  I2CLease bus(I2C_DEV_KEYPAD);
+  keypad_.disableInterrupts();
+}
+
+void PocketmageKB::enableInterrupts() {
+  I2CLease bus(I2C_DEV_KEYPAD);
+  keypad_.enableInterrupts();
+}
+
+void PocketmageKB::flush() {
+  I2CLease bus(I2C_DEV_KEYPAD);
+  keypad_.flush();
 }
 
 // Wire function for keyboard class
@@ -724,12 +749,14 @@ char PocketmageKB::updateKeypress() {
 
   // Check for keypad char
   if (TCA8418_event_ == true) {
-    int k = keypad_.getEvent();
+    uint8_t k = 0;
+    I2C().readFifo(I2C_DEV_KEYPAD, TCA8418_DEFAULT_ADDR, TCA8418_REG_KEY_EVENT_A, &k, 1);
     
     //  try to clear the IRQ flag
     //  if there are pending events it is not cleared
-    keypad_.writeRegister(TCA8418_REG_INT_STAT, 1);
-    int intstat = keypad_.readRegister(TCA8418_REG_INT_STAT);
+    uint8_t intstat = 0;
+    I2C().writeReg(I2C_DEV_KEYPAD, TCA8418_DEFAULT_ADDR, TCA8418_REG_INT_STAT, 1);
+    I2C().readRegs(I2C_DEV_KEYPAD, TCA8418_DEFAULT_ADDR, TCA8418_REG_INT_STAT, &intstat, 1);
     if ((intstat & 0x01) == 0) TCA8418_event_ = false;
 
     if (k & 0x80) {   //Key pressed, not released
@@ -760,9 +787,9 @@ char PocketmageKB::updateKeypress() {
 }
 
 void PocketmageKB::checkUSBKB() {
-  // Check if USB Keyboard has been connected
-  bool needBoost;
-  PowerSystem.getOTGNeed(needBoost);
+  // Check if USB Keyboard has been connected (OTG state comes from the power service)
+  if (!pocketmage::power::takePowerEvents(pocketmage::power::POWER_EVT_OTG)) return;
+  bool needBoost = pocketmage::power::getPowerSnapshot().otgNeeded;
   if (needBoost) {
     // Enable boost if not already on
     bool boostOn;
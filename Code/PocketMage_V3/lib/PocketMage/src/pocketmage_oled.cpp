@@ -22,7 +22,7 @@ void setupOled() {
   u8g2.setBusClock(10000000);
   u8g2.setPowerSave(0);
   u8g2.clearBuffer();
-  u8g2.sendBuffer();
+  pm_oled.sendBuffer();
 
   // SHOW "PocketMage" while DEVICE BOOTS
   OLED().oledWord("   PocketMage   ", true, false);
@@ -31,59 +31,32 @@ void setupOled() {
 // oled object reference for other apps
 PocketmageOled& OLED() { return pm_oled; }
 
+// oledWord font cascade, largest first
+const PocketmageOled::OledWordFont PocketmageOled::OLED_WORD_FONTS[PocketmageOled::OLED_WORD_FONT_COUNT] = {
+  { u8g2_font_ncenB18_tr, 5 },
+  { u8g2_font_ncenB14_tr, 3 },
+  { u8g2_font_ncenB12_tr, 2 },
+  { u8g2_font_ncenB10_tr, 1 },
+  { u8g2_font_ncenB08_tr, 0 },
+};
+
 // ===================== public functions =====================
 void PocketmageOled::oledWord(String word, bool allowLarge, bool showInfo) {
   u8g2_.clearBuffer();
 
   if (showInfo) infoBar();
 
-  if (allowLarge) {
-    /*u8g2_.setFont(u8g2_font_ncenB24_tr);
-    if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-      u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16+12,word.c_str());
-      u8g2_.sendBuffer();
-      return;
-    }*/
-    u8g2_.setFont(u8g2_font_ncenB18_tr);
-    if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-      u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16+5,word.c_str());
-      u8g2_.sendBuffer();
-      return;
-    }
-  }
+  uint16_t width = 0;
+  const uint8_t idx = fitWordFont(word.c_str(), allowLarge ? 0 : 1, width);
+  const OledWordFont& f = OLED_WORD_FONTS[idx];
 
-  u8g2_.setFont(u8g2_font_ncenB14_tr);
-  if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16+3,word.c_str());
-    u8g2_.sendBuffer();
-    return;
-  }
-
-  u8g2_.setFont(u8g2_font_ncenB12_tr);
-  if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16+2,word.c_str());
-    u8g2_.sendBuffer();
-    return;
-  }
-
-  u8g2_.setFont(u8g2_font_ncenB10_tr);
-  if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16+1,word.c_str());
-    u8g2_.sendBuffer();
-    return;
-  }
-
-  u8g2_.setFont(u8g2_font_ncenB08_tr);
-  if (u8g2_.getStrWidth(word.c_str()) < u8g2_.getDisplayWidth()) {
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()))/2,16,word.c_str());
-    u8g2_.sendBuffer();
-    return;
+  u8g2_.setFont(f.font);
+  if (width < u8g2_.getDisplayWidth()) {
+    u8g2_.drawStr((u8g2_.getDisplayWidth() - width)/2, 16+f.yOffset, word.c_str());
   } else {
-    u8g2_.drawStr(u8g2_.getDisplayWidth() - u8g2_.getStrWidth(word.c_str()),16,word.c_str());
-    u8g2_.sendBuffer();
-    return;
+    u8g2_.drawStr(u8g2_.getDisplayWidth() - width, 16, word.c_str());
   }
-  
+  sendBuffer();
 }
 
 void PocketmageOled::oledLine(String line, bool doProgressBar, String bottomMsg) {
@@ -143,14 +116,15 @@ void PocketmageOled::oledLine(String line, bool doProgressBar, String bottomMsg)
 
   // DRAW LINE TEXT (unchanged)
   u8g2_.setFont(u8g2_font_ncenB18_tr);
-  if (u8g2_.getStrWidth(line.c_str()) < (u8g2_.getDisplayWidth() - 5)) {
+  const uint16_t lineWidth = u8g2Width(line.c_str());
+  if (lineWidth < (u8g2_.getDisplayWidth() - 5)) {
     u8g2_.drawStr(0, 20, line.c_str());
-    if (line.length() > 0) u8g2_.drawVLine(u8g2_.getStrWidth(line.c_str()) + 2, 1, 22);
+    if (line.length() > 0) u8g2_.drawVLine(lineWidth + 2, 1, 22);
   } else {
-    u8g2_.drawStr(u8g2_.getDisplayWidth()-8-u8g2_.getStrWidth(line.c_str()), 20, line.c_str());
+    u8g2_.drawStr(u8g2_.getDisplayWidth()-8-lineWidth, 20, line.c_str());
   }
 
-  u8g2_.sendBuffer();
+  sendBuffer();
 }
 
 void PocketmageOled::infoBar() {
@@ -161,10 +135,10 @@ void PocketmageOled::infoBar() {
 
   switch (state) {
     case 1:
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth("SHIFT")) / 2, u8g2_.getDisplayHeight(), "SHIFT");
+    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2Width("SHIFT")) / 2, u8g2_.getDisplayHeight(), "SHIFT");
     break;
     case 2:
-    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2_.getStrWidth("FN")) / 2,    u8g2_.getDisplayHeight(), "FN");
+    u8g2_.drawStr((u8g2_.getDisplayWidth() - u8g2Width("FN")) / 2,    u8g2_.getDisplayHeight(), "FN");
     break;
     default:
     break;
@@ -183,19 +157,13 @@ void PocketmageOled::infoBar() {
   // CLOCK
   if (SYSTEM_CLOCK) {
     u8g2_.setFont(u8g2_font_5x7_tf);
-    DateTime now = CLOCK().nowDT();
-    
-    // shortened time format
-    String timeString = String(now.hour()) + ":" + (now.minute() < 10 ? "0" : "") + String(now.minute());
-    u8g2_.drawStr(infoWidth, u8g2_.getDisplayHeight(), timeString.c_str());
+    updateClockStrings();
 
-    String day3Char = String(daysOfTheWeek[now.dayOfTheWeek()]);
-    day3Char = day3Char.substring(0, 3);
-    if (SHOW_YEAR) day3Char += (" " + String(now.month()) + "/" + String(now.day()) + "/" + String(now.year()).substring(2,4));
-    else           day3Char += (" " + String(now.month()) + "/" + String(now.day()));
-    u8g2_.drawStr(u8g2_.getDisplayWidth() - u8g2_.getStrWidth(day3Char.c_str()), u8g2_.getDisplayHeight(), day3Char.c_str());    
+    // shortened time format
+    u8g2_.drawStr(infoWidth, u8g2_.getDisplayHeight(), timeStr_);
+    u8g2_.drawStr(u8g2_.getDisplayWidth() - u8g2Width(dateStr_), u8g2_.getDisplayHeight(), dateStr_);
 
-    infoWidth += (u8g2_.getStrWidth(timeString.c_str()) + 6);
+    infoWidth += (u8g2Width(timeStr_) + 6);
   }
 
   // MSC Indicator
@@ -203,7 +171,7 @@ void PocketmageOled::infoBar() {
     u8g2_.setFont(u8g2_font_5x7_tf);
     u8g2_.drawStr(infoWidth, u8g2_.getDisplayHeight(), "USB");
 
-    infoWidth += (u8g2_.getStrWidth("USB") + 6);
+    infoWidth += (u8g2Width("USB") + 6);
   }
 
   // Sink Indicator
@@ -211,7 +179,7 @@ void PocketmageOled::infoBar() {
     u8g2_.setFont(u8g2_font_5x7_tf);
     u8g2_.drawStr(infoWidth, u8g2_.getDisplayHeight(), "SNK");
 
-    infoWidth += (u8g2_.getStrWidth("SNK") + 6);
+    infoWidth += (u8g2Width("SNK") + 6);
   }
 
   // SD Indicator 
@@ -219,7 +187,7 @@ void PocketmageOled::infoBar() {
     u8g2_.setFont(u8g2_font_5x7_tf);
     u8g2_.drawStr(infoWidth, u8g2_.getDisplayHeight(), "SD");
 
-    infoWidth += (u8g2_.getStrWidth("SD") + 6);
+    infoWidth += (u8g2Width("SD") + 6);
   }
 }
 
@@ -270,11 +238,204 @@ void PocketmageOled::oledScroll() {
   }
 
   // SEND BUFFER 
-  u8g2_.sendBuffer();
+  sendBuffer();
+}
+
+// Push the frame, skipping tiles the panel already shows. Each tile row
+// sends one span from its first to its last changed tile.
+void PocketmageOled::sendBuffer() {
+  uint8_t* buf = u8g2_.getBufferPtr();
+  const uint8_t tw = u8g2_.getBufferTileWidth();
+  const uint8_t th = u8g2_.getBufferTileHeight();
+  const uint16_t rowBytes = tw * 8;
+  const uint16_t size = rowBytes * th;
+
+  if (!shadowValid_ || size > SHADOW_SIZE) {
+    u8g2_.sendBuffer();
+    if (size <= SHADOW_SIZE) {
+      memcpy(shadow_, buf, size);
+      shadowValid_ = true;
+    }
+    stats_.framesSent++;
+    stats_.bytesSent += size;
+    return;
+  }
+
+  uint32_t sent = 0;
+  for (uint8_t ty = 0; ty < th; ty++) {
+    const uint8_t* row = buf + ty * rowBytes;
+    uint8_t* old = shadow_ + ty * rowBytes;
+    if (memcmp(row, old, rowBytes) == 0) continue;
+
+    uint8_t first = 0;
+    while (memcmp(row + first * 8, old + first * 8, 8) == 0) first++;
+    uint8_t last = tw - 1;
+    while (memcmp(row + last * 8, old + last * 8, 8) == 0) last--;
+
+    const uint8_t span = last - first + 1;
+    u8g2_.updateDisplayArea(first, ty, span, 1);
+    memcpy(old + first * 8, row + first * 8, span * 8);
+    sent += span * 8;
+  }
+
+  if (sent == 0) {
+    stats_.framesSkipped++;
+  } else {
+    stats_.framesSent++;
+    stats_.bytesSent += sent;
+  }
+}
+
+void PocketmageOled::printStats() {
+  const unsigned long now = millis();
+  const unsigned long elapsed = now - printedAt_;
+  if (elapsed == 0) return;
+
+  const OledStats& p = printed_;
+  ESP_LOGD(tag, "%lu frames/s sent, %lu frames/s skipped, %lu B/s",
+           (unsigned long)((stats_.framesSent - p.framesSent) * 1000UL / elapsed),
+           (unsigned long)((stats_.framesSkipped - p.framesSkipped) * 1000UL / elapsed),
+           (unsigned long)((stats_.bytesSent - p.bytesSent) * 1000UL / elapsed));
+  printed_ = stats_;
+  printedAt_ = now;
 }
 
 // ===================== private functions =====================
 // COMPUTE STRING WIDTH IN EINK PIXELS
+// Sums glyph advances from the e-ink font table instead of running
+// getTextBounds, so OLED echo never touches the e-ink font engine.
 uint16_t PocketmageOled::strWidth(const String& s) const {
-  return EINK().getEinkTextWidth(s);
+  const GFXfont* font = EINK().getCurrentFont();
+  if (!font || !font->glyph) return EINK().getEinkTextWidth(s);
+
+  uint16_t width = 0;
+  for (size_t i = 0; i < s.length(); i++) {
+    const uint8_t c = (uint8_t)s[i];
+    if (c < font->first || c > font->last) continue;
+    width += pgm_read_byte(&font->glyph[c - font->first].xAdvance);
+  }
+  return width;
+}
+
+// COMPUTE STRING WIDTH IN OLED PIXELS (current U8g2 font, cached)
+uint16_t PocketmageOled::u8g2Width(const char* s) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  size_t len = 0;
+  for (const char* p = s; *p; p++, len++) {
+    hash ^= (uint8_t)*p;
+    hash *= 16777619u;
+  }
+  if (len > WIDTH_KEY_MAX) return u8g2_.getStrWidth(s);
+
+  const uint8_t* font = u8g2_.getU8g2()->font;
+  uint8_t victim = 0;
+  for (uint8_t i = 0; i < WIDTH_CACHE_SIZE; i++) {
+    WidthCacheEntry& e = widthCache_[i];
+    if (e.font == font && e.hash == hash && strcmp(e.key, s) == 0) {
+      if (e.hits == UINT8_MAX) {
+        // Age every entry so old favourites can be replaced eventually
+        for (auto& other : widthCache_) other.hits /= 2;
+      }
+      e.hits++;
+      return e.width;
+    }
+    if (e.hits < widthCache_[victim].hits) victim = i;
+  }
+
+  WidthCacheEntry& e = widthCache_[victim];
+  e.hash  = hash;
+  e.font  = font;
+  e.width = u8g2_.getStrWidth(s);
+  e.hits  = 0;
+  memcpy(e.key, s, len + 1);
+  return e.width;
+}
+
+// REBUILD STATUS BAR CLOCK TEXT WHEN THE MINUTE CHANGES
+void PocketmageOled::updateClockStrings() {
+  DateTime now = CLOCK().cachedNow();
+  const uint32_t minute = now.unixtime() / 60;
+  if (minute == clockMinute_ && timeStr_[0] != '\0') return;
+  clockMinute_ = minute;
+
+  snprintf(timeStr_, sizeof(timeStr_), "%d:%02d", now.hour(), now.minute());
+  if (SHOW_YEAR)
+    snprintf(dateStr_, sizeof(dateStr_), "%.3s %d/%d/%02d", daysOfTheWeek[now.dayOfTheWeek()],
+             now.month(), now.day(), now.year() % 100);
+  else
+    snprintf(dateStr_, sizeof(dateStr_), "%.3s %d/%d", daysOfTheWeek[now.dayOfTheWeek()],
+             now.month(), now.day());
+}
+
+// PICK THE LARGEST OLEDWORD FONT THAT FITS
+// Same result as measuring every font top-down, but the first measurement
+// is scaled by each font's max advance to guess the answer, so a miss
+// usually costs two or three getStrWidth calls. Hits cost none.
+uint8_t PocketmageOled::fitWordFont(const char* s, uint8_t start, uint16_t& width) {
+  const uint16_t avail = u8g2_.getDisplayWidth();
+
+  uint32_t hash = 2166136261u;
+  size_t len = 0;
+  for (const char* p = s; *p; p++, len++) {
+    hash ^= (uint8_t)*p;
+    hash *= 16777619u;
+  }
+
+  for (uint8_t i = 0; i < FIT_CACHE_SIZE; i++) {
+    const FitCacheEntry& e = fitCache_[i];
+    if (e.valid && e.hash == hash && e.len == len && e.avail == avail && e.start == start) {
+      width = e.width;
+      return e.fontIdx;
+    }
+  }
+
+  if (fontMaxAdvance_[0] == 0) {
+    for (uint8_t i = 0; i < OLED_WORD_FONT_COUNT; i++) {
+      u8g2_.setFont(OLED_WORD_FONTS[i].font);
+      fontMaxAdvance_[i] = max<uint8_t>(1, u8g2_.getMaxCharWidth());
+    }
+  }
+
+  auto measure = [&](uint8_t idx) -> uint16_t {
+    u8g2_.setFont(OLED_WORD_FONTS[idx].font);
+    return u8g2_.getStrWidth(s);
+  };
+
+  const uint8_t last = OLED_WORD_FONT_COUNT - 1;
+  uint8_t  idx = start;
+  uint16_t w   = measure(start);
+
+  if (w >= avail && start < last) {
+    // Guess the first font whose scaled width fits, then walk to the exact answer
+    const uint16_t w0 = w;
+    idx = last;
+    for (uint8_t i = start + 1; i < last; i++) {
+      if ((uint32_t)w0 * fontMaxAdvance_[i] / fontMaxAdvance_[start] < avail) { idx = i; break; }
+    }
+    w = measure(idx);
+
+    if (w < avail) {
+      // Guessed too small? Try the larger fonts above it
+      while (idx > start + 1) {
+        const uint16_t up = measure(idx - 1);
+        if (up >= avail) break;
+        idx--;
+        w = up;
+      }
+    } else {
+      while (idx < last) {
+        idx++;
+        w = measure(idx);
+        if (w < avail) break;
+      }
+    }
+  }
+
+  FitCacheEntry& e = fitCache_[fitCacheNext_];
+  fitCacheNext_ = (fitCacheNext_ + 1) % FIT_CACHE_SIZE;
+  e = { hash, (uint16_t)len, avail, w, idx, start, true };
+
+  width = w;
+  return idx;
 }
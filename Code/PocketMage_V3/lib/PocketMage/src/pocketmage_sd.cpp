@@ -21,31 +21,54 @@ static PocketmageSD pm_sd;
 //   - setupBZ()
 //   - setupEINK()
 void setupSD() {
+  if (!mountSD()) {
+    reportNoSD();
+    return;
+  }
+  provisionSD();
+}
+
+// Mount the card. No UI, safe to run from the boot task.
+bool mountSD() {
   SD_MMC.setPins(SD_CLK, SD_CMD, SD_D0);
   if (!SD_MMC.begin("/sdcard", true) || SD_MMC.cardType() == CARD_NONE) {
     ESP_LOGE(tag, "MOUNT FAILED");
+    return false;
+  }
+  return true;
+}
 
-    OLED().oledWord("SD Card Not Detected!");
-    delay(2000);
-    if (ALLOW_NO_MICROSD) {
-      OLED().oledWord("All Work Will Be Lost!");
-      delay(5000);
-      SD().setNoSD(true);
-    }
-    else {
-      OLED().oledWord("Insert SD Card and Reboot!");
-      delay(5000);
-      // Put OLED to sleep
-      OLED().setPowerSave(1);
-      // Shut Down Jingle
-      BZ().playJingle(Jingles::Shutdown);
-      // Sleep
-      esp_deep_sleep_start();
-      return;
-    }
+// Tell the user the card is missing, then carry on without it or sleep
+void reportNoSD() {
+  OLED().oledWord("SD Card Not Detected!");
+  delay(2000);
+  if (ALLOW_NO_MICROSD) {
+    OLED().oledWord("All Work Will Be Lost!");
+    delay(5000);
+    SD().setNoSD(true);
+  }
+  else {
+    OLED().oledWord("Insert SD Card and Reboot!");
+    delay(5000);
+    // Put OLED to sleep
+    OLED().setPowerSave(1);
+    // Shut Down Jingle
+    BZ().playJingle(Jingles::Shutdown);
+    // Sleep
+    esp_deep_sleep_start();
+  }
+}
+
+// Create the folder tree and system files once per card. The marker holds
+// the layout version; bump SD_LAYOUT_VERSION when adding folders here.
+void provisionSD() {
+  if (SD_MMC.exists(SD_PROVISION_MARKER)) {
+    File m = SD_MMC.open(SD_PROVISION_MARKER, FILE_READ);
+    const int version = m ? m.parseInt() : 0;
+    if (m) m.close();
+    if (version >= SD_LAYOUT_VERSION) return;
   }
 
-  setCpuFrequencyMhz(240);
   // Create folders and files if needed
   if (!SD_MMC.exists("/sys"))                 SD_MMC.mkdir( "/sys"                );
   if (!SD_MMC.exists("/notes"))               SD_MMC.mkdir( "/notes"              );
@@ -53,7 +76,6 @@ void setupSD() {
   if (!SD_MMC.exists("/dict"))                SD_MMC.mkdir( "/dict"               );
   if (!SD_MMC.exists("/apps"))                SD_MMC.mkdir( "/apps"               );
   if (!SD_MMC.exists("/apps/temp"))           SD_MMC.mkdir( "/apps/temp"          );
-  if (!SD_MMC.exists("/notes"))               SD_MMC.mkdir( "/notes"              );
   if (!SD_MMC.exists("/assets"))              SD_MMC.mkdir( "/assets"             );
   if (!SD_MMC.exists("/assets/backgrounds"))  SD_MMC.mkdir( "/assets/backgrounds" );
 
@@ -77,6 +99,13 @@ void setupSD() {
     File f = SD_MMC.open("/sys/SDMMC_META.txt", FILE_WRITE);
     if (f) f.close();
   }
+
+  File m = SD_MMC.open(SD_PROVISION_MARKER, FILE_WRITE);
+  if (m) {
+    m.print(SD_LAYOUT_VERSION);
+    m.close();
+  }
+  ESP_LOGI(tag, "SD provisioned (layout %d)", SD_LAYOUT_VERSION);
 }
 
 // Access for other apps
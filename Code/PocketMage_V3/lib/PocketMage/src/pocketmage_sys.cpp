@@ -16,6 +16,12 @@
 #include "esp_partition.h"
 #include "esp_ota_ops.h"
 #include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_rom_crc.h"
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#include "driver/gpio.h"
 
 static constexpr const char* TAG = "SYSTEM";
 // To Do: migrate to pocketmage::
@@ -53,57 +59,138 @@ bool sinkEnabled        = false;
 volatile bool SDActive  = false;
 volatile int battState = 0;           // Bary state
 
+// ------------------ Boot Sequencer ------------------
+// Boot runs in three lanes: the main task (OLED, buzzer, E-Ink on SPI), an
+// I2C task (keypad, power IC, touch, RTC) and an SD task (mount + one-time
+// provisioning). The app is only started once the I2C and SD lanes join.
+static EventGroupHandle_t bootGroup = NULL;
+static constexpr EventBits_t BOOT_I2C_DONE = 1 << 0;
+static constexpr EventBits_t BOOT_SD_DONE  = 1 << 1;
+static volatile bool bootSDMounted  = false;
+static volatile bool bootKBReady    = false;
+static volatile bool bootTouchReady = false;
+
+static int64_t bootStart = 0;
+static void logBootPhase(const char* phase, int64_t phaseStart) {
+  const int64_t now = esp_timer_get_time();
+  ESP_LOGI(TAG, "BOOT %-6s %5lu ms (t=%lu ms)", phase,
+           (unsigned long)((now - phaseStart) / 1000), (unsigned long)((now - bootStart) / 1000));
+}
+
+static void bootI2CTask(void* parameter) {
+  int64_t t = esp_timer_get_time();
+
+  // KEYBOARD SETUP
+  bootKBReady = setupKB(KB_IRQ);
+  logBootPhase("KB", t);
+
+  // POWER SETUP
+  t = esp_timer_get_time();
+  if (!PowerSystem.init(I2C_SDA, I2C_SCL)) {
+    ESP_LOGV(TAG, "MP2722 Failed to Init");
+  }
+  pocketmage::power::startPowerService();
+  logBootPhase("POWER", t);
+
+  // CAPACATIVE TOUCH SETUP
+  t = esp_timer_get_time();
+  bootTouchReady = setupTouch();
+  logBootPhase("TOUCH", t);
+
+  // RTC SETUP
+  t = esp_timer_get_time();
+  setupClock();
+  logBootPhase("RTC", t);
+
+  xEventGroupSetBits(bootGroup, BOOT_I2C_DONE);
+  vTaskDelete(NULL);
+}
+
+static void bootSDTask(void* parameter) {
+  const int64_t t = esp_timer_get_time();
+
+  // SD CARD SETUP (failure is reported from the main task)
+  bootSDMounted = mountSD();
+  if (bootSDMounted) provisionSD();
+  logBootPhase("SD", t);
+
+  xEventGroupSetBits(bootGroup, BOOT_SD_DONE);
+  vTaskDelete(NULL);
+}
+
 void PocketMage_INIT(){
+  bootStart = esp_timer_get_time();
+  int64_t t = bootStart;
+
+  // Full speed while booting, power save is applied at the end
+  setCpuFrequencyMhz(240);
+
   // Serial, I2C, SPI
   Serial.begin(115200);
   Wire.begin(I2C_SDA, I2C_SCL);
+  setupI2C();
   SPI.begin(SPI_SCK, -1, SPI_MOSI, -1);
 
-  // OLED SETUP
+  // OLED SETUP (first frame)
   setupOled();
+  logBootPhase("OLED", t);
 
-  // STARTUP JINGLE
-  setupBZ();
-  
-  // WAKE INTERRUPT SETUP
+  // WAKE INTERRUPT SETUP (before setupKB attaches its handler)
   pinMode(KB_IRQ, INPUT);
   esp_sleep_enable_ext0_wakeup(GPIO_NUM_8, 0);
 
-  // KEYBOARD SETUP
-  setupKB(KB_IRQ);
+  // Start the I2C and SD lanes
+  bootGroup = xEventGroupCreate();
+  xTaskCreatePinnedToCore(bootI2CTask, "bootI2C", 4096, NULL, 2, NULL, 0);
+  xTaskCreatePinnedToCore(bootSDTask,  "bootSD",  4096, NULL, 2, NULL, 0);
+
+  // STARTUP JINGLE
+  setupBZ();
 
   // EINK HANDLER SETUP
+  t = esp_timer_get_time();
   setupEink();
-  
-  // SD CARD SETUP
-  setupSD();
+  logBootPhase("EINK", t);
 
-  // POWER SETUP
+  // POWER BUTTON / SENSE PINS
   pinMode(PWR_BTN, INPUT_PULLUP);
   attachInterrupt(digitalPinToInterrupt(PWR_BTN), pocketmage::power::PWR_BTN_irq, FALLING);
   pinMode(CHRG_SENS, INPUT);
   pinMode(BAT_SENS, INPUT);
-  if (!PowerSystem.init(I2C_SDA, I2C_SCL)) {
-    ESP_LOGV(TAG, "MP2722 Failed to Init");
-  }
   //WiFi.mode(WIFI_OFF);
   //btStop();
 
+  // Join the I2C lane. Its failures are reported here so the OLED is
+  // only driven from this task.
+  t = esp_timer_get_time();
+  xEventGroupWaitBits(bootGroup, BOOT_I2C_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+  logBootPhase("JOIN I2C", t);
+  if (!bootKBReady)    reportKBFailed();
+  if (!bootTouchReady) reportTouchFailed();
+
+  // Join the SD lane. This is not deferred to the first SD() call: the
+  // apps and file helpers use SD_MMC directly in many places, and
+  // loadState() starts the boot app, whose INIT reads the card right
+  // away, so there is no single first-use point to hang the join on.
+  t = esp_timer_get_time();
+  xEventGroupWaitBits(bootGroup, BOOT_SD_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
+  vEventGroupDelete(bootGroup);
+  bootGroup = NULL;
+  logBootPhase("JOIN SD", t);
+  if (!bootSDMounted) reportNoSD();
+
   // SET CPU CLOCK FOR POWER SAVE MODE
   if (SAVE_POWER) setCpuFrequencyMhz(40 );
   else            setCpuFrequencyMhz(240);
-  
-  // CAPACATIVE TOUCH SETUP
-  setupTouch();
-
-  // RTC SETUP
-  setupClock();
+  pocketmage::power::configureLightSleep();
 
   // Set "random" seed
   randomSeed(analogRead(BAT_SENS));
 
   // Load State
+  t = esp_timer_get_time();
   pocketmage::power::loadState();
+  logBootPhase("APP", t);
 }
 
 // Helpers
@@ -138,7 +225,7 @@ namespace pocketmage::file{
 
         if (SD().getEditingFile() == "" || SD().getEditingFile() == "-")
         SD().setEditingFile("/temp.txt");
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         if (!SD().getEditingFile().startsWith("/"))
         SD().setEditingFile("/" + SD().getEditingFile());
         //OLED().oledWord("Saving File: "+ editingFile);
@@ -149,7 +236,7 @@ namespace pocketmage::file{
         pocketmage::file::writeMetadata(SD().getEditingFile());
 
         // delay(1000);
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
         if (SAVE_POWER)
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
         SDActive = false;
@@ -172,12 +259,20 @@ namespace pocketmage::file{
     size_t fileSizeBytes = file.size();
     file.close();
 
-    // Format size string
-    String fileSizeStr = String(fileSizeBytes) + " Bytes";
-
     // Get line and char counts
     int charCount = countVisibleChars(SD().readFileToString(SD_MMC, path.c_str()));
 
+    writeMetadata(path, fileSizeBytes, charCount);
+    }
+
+    // Record metadata from counts the caller already has, without re-reading the file
+    void writeMetadata(const String& path, size_t fileSizeBytes, int charCount) {
+    SDActive = true;
+    setCpuFrequencyMhz(240);
+
+    // Format size string
+    String fileSizeStr = String(fileSizeBytes) + " Bytes";
+
     String charStr = String(charCount) + " Char";
     // Get current time from RTC
     DateTime now = CLOCK().nowDT();
@@ -239,7 +334,7 @@ namespace pocketmage::file{
         setCpuFrequencyMhz(240);
         delay(50);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         if (showOLED)
         OLED().oledWord("Loading File");
         if (!SD().getEditingFile().startsWith("/"))
@@ -248,7 +343,7 @@ namespace pocketmage::file{
         ESP_LOGV(TAG, "Text to load: %s", textToLoad.c_str());
 
         stringToVector(textToLoad);
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
         if (showOLED) {
         OLED().oledWord("File Loaded");
         delay(200);
@@ -269,7 +364,7 @@ namespace pocketmage::file{
         setCpuFrequencyMhz(240);
         delay(50);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         // OLED().oledWord("Deleting File: "+ fileName);
         if (!fileName.startsWith("/"))
         fileName = "/" + fileName;
@@ -280,7 +375,7 @@ namespace pocketmage::file{
         pocketmage::file::deleteMetadata(fileName);
 
         delay(1000);
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
         if (SAVE_POWER)
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
         SDActive = false;
@@ -339,20 +434,20 @@ namespace pocketmage::file{
         setCpuFrequencyMhz(240);
         delay(50);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         // OLED().oledWord("Renaming "+ oldFile + " to " + newFile);
         if (!oldFile.startsWith("/"))
         oldFile = "/" + oldFile;
         if (!newFile.startsWith("/"))
         newFile = "/" + newFile;
+        // Same volume, so this is a FAT directory entry update with no data copy
         SD().renameFile(SD_MMC, oldFile.c_str(), newFile.c_str());
         OLED().oledWord(oldFile + " -> " + newFile);
-        delay(1000);
 
         // Update MetaData
         pocketmage::file::renMetadata(oldFile, newFile);
 
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
         if (SAVE_POWER)
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
         SDActive = false;
@@ -414,36 +509,121 @@ namespace pocketmage::file{
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
     }
     
-    void copyFile(String oldFile, String newFile) {
+    // Stream oldFile to newFile through one reusable DMA-capable block buffer.
+    // verify re-reads the copy and compares CRC32s.
+    bool copyFile(String oldFile, String newFile, bool verify, CopyProgress progress) {
     if (SD().getNoSD()) {
         OLED().oledWord("COPY FAILED - No SD!");
         delay(5000);
-        return;
-    } else {
-        SDActive = true;
-        setCpuFrequencyMhz(240);
-        delay(50);
+        return false;
+    }
 
-        keypad.disableInterrupts();
-        OLED().oledWord("Loading File");
-        if (!oldFile.startsWith("/"))
+    static uint8_t* copyBuf = nullptr;
+    if (!copyBuf) copyBuf = (uint8_t*)heap_caps_malloc(COPY_BUF_SIZE, MALLOC_CAP_DMA);
+    if (!copyBuf) {
+        ESP_LOGE(TAG, "No memory for copy buffer");
+        return false;
+    }
+
+    if (!oldFile.startsWith("/"))
         oldFile = "/" + oldFile;
-        if (!newFile.startsWith("/"))
+    if (!newFile.startsWith("/"))
         newFile = "/" + newFile;
-        String textToLoad = SD().readFileToString(SD_MMC, (oldFile).c_str());
-        SD().writeFile(SD_MMC, (newFile).c_str(), textToLoad.c_str());
+
+    // The copy replaces the destination, so it must not be the source.
+    // FAT names are case-insensitive.
+    if (oldFile.equalsIgnoreCase(newFile)) {
+        ESP_LOGE(TAG, "Copy onto itself: %s", oldFile.c_str());
+        OLED().oledWord("COPY FAILED - Same name");
+        return false;
+    }
+
+    SDActive = true;
+    setCpuFrequencyMhz(240);
+    const bool prevNoTimeout = noTimeout;
+    noTimeout = true;
+    KB().disableInterrupts();
+
+    const int64_t start = esp_timer_get_time();
+    // Copy into a temp file so an existing destination survives a failure
+    const String tmpFile = newFile + ".tmp";
+    File src = SD_MMC.open(oldFile.c_str(), FILE_READ);
+    File dst;
+    if (src && !src.isDirectory())
+        dst = SD_MMC.open(tmpFile.c_str(), FILE_WRITE);
+    const bool dstOpened = (bool)dst;
+    bool ok = dstOpened;
+
+    const size_t total = ok ? src.size() : 0;
+    size_t copied = 0;
+    int charCount = 0;
+    uint32_t crc = 0;
+
+    while (ok && copied < total) {
+        const size_t n = src.read(copyBuf, COPY_BUF_SIZE);
+        if (n == 0 || dst.write(copyBuf, n) != n) {
+        ok = false;
+        break;
+        }
+        for (size_t i = 0; i < n; i++)
+        if (copyBuf[i] >= 32 && copyBuf[i] <= 126) charCount++;
+        if (verify) crc = esp_rom_crc32_le(crc, copyBuf, n);
+        copied += n;
+        if (progress) progress(copied, total);
+    }
+    if (src) src.close();
+    if (dst) dst.close();
+
+    if (ok && verify) {
+        File check = SD_MMC.open(tmpFile.c_str(), FILE_READ);
+        uint32_t checkCrc = 0;
+        size_t checked = 0;
+        while (check && check.available()) {
+        const size_t n = check.read(copyBuf, COPY_BUF_SIZE);
+        if (n == 0) break;
+        checkCrc = esp_rom_crc32_le(checkCrc, copyBuf, n);
+        checked += n;
+        }
+        if (check) check.close();
+        ok = (checked == total && checkCrc == crc);
+        if (!ok) ESP_LOGE(TAG, "Copy verify failed: %s", newFile.c_str());
+    }
+
+    // Swap the copy in. If the old destination is already gone when the
+    // rename fails, the temp file is the only copy left, so it is kept.
+    bool keepTmp = false;
+    if (ok) {
+        const bool replacing = SD_MMC.exists(newFile.c_str());
+        if (replacing && !SD_MMC.remove(newFile.c_str())) ok = false;
+        else if (!SD_MMC.rename(tmpFile.c_str(), newFile.c_str())) {
+        ok = false;
+        keepTmp = replacing;
+        }
+    }
+
+    if (ok) {
+        const uint32_t us = max<int64_t>(1, esp_timer_get_time() - start);
+        ESP_LOGI(TAG, "Copied %s -> %s: %u bytes, %lu KB/s%s", oldFile.c_str(), newFile.c_str(),
+                 (unsigned)total, (unsigned long)((uint64_t)total * 1000000ULL / 1024 / us),
+                 verify ? ", verified" : "");
         OLED().oledWord("Saved: " + newFile);
 
         // Write MetaData
-        pocketmage::file::writeMetadata(newFile);
-
-        delay(1000);
-        keypad.enableInterrupts();
+        pocketmage::file::writeMetadata(newFile, total, charCount);
+    } else {
+        ESP_LOGE(TAG, "Copy failed: %s -> %s", oldFile.c_str(), newFile.c_str());
+        OLED().oledWord("COPY FAILED");
+        // Drop the temp copy; the destination is only replaced on success
+        if (dstOpened && !keepTmp && SD_MMC.exists(tmpFile.c_str()))
+            SD_MMC.remove(tmpFile.c_str());
+    }
 
-        if (SAVE_POWER)
+    KB().enableInterrupts();
+    noTimeout = prevNoTimeout;
+    if (SAVE_POWER)
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
-        SDActive = false;
-    }
+    SDActive = false;
+    return ok;
     }
     
     void appendToFile(String path, String inText) {
@@ -456,13 +636,13 @@ namespace pocketmage::file{
         setCpuFrequencyMhz(240);
         delay(50);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         SD().appendFile(SD_MMC, path.c_str(), inText.c_str());
 
         // Write MetaData
         pocketmage::file::writeMetadata(path);
 
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         if (SAVE_POWER)
         setCpuFrequencyMhz(POWER_SAVE_FREQ);
@@ -489,7 +669,7 @@ namespace pocketmage::time{
     }
 
     DateTime now = CLOCK().nowDT();  // Get current date
-    CLOCK().getRTC().adjust(DateTime(now.year(), now.month(), now.day(), hours, minutes, 0));
+    CLOCK().adjust(DateTime(now.year(), now.month(), now.day(), hours, minutes, 0));
 
     ESP_LOGI(TAG, "Time updated!");
     }
@@ -513,7 +693,7 @@ namespace pocketmage::time{
             OLED().oledWord("Good Save!");
             delay(500);
             CLOCK().setPrevTimeMillis(millis());
-            keypad.flush();
+            KB().flush();
             return;
             }
         }
@@ -594,7 +774,6 @@ namespace pocketmage::time{
         CurrentAppState = HOME;
         CurrentHOMEState = NOWLATER;
         updateTaskArray();
-        sortTasksByDueDate(tasks);
 
         u8g2.setPowerSave(1);
         OLEDPowerSave = true;
@@ -647,7 +826,7 @@ namespace pocketmage::time{
         else CurrentAppState = static_cast<AppState>(prefs.getInt("CurrentAppState", HOME));
         prefs.end();*/
         pocketmage::power::loadState();
-        keypad.flush();
+        KB().flush();
 
         CurrentHOMEState = HOME_HOME;
         PWR_BTN_event = false;
@@ -684,6 +863,7 @@ namespace pocketmage::time{
 
     if (isValid) {
         setCpuFrequencyMhz(newFreq);
+        pocketmage::power::configureLightSleep();  // keep the PM max frequency in step
         ESP_LOGI(TAG, "CPU Speed changed to: %d MHz", newFreq);
     }
     }
@@ -778,71 +958,313 @@ namespace pocketmage::power{
     
     void IRAM_ATTR PWR_BTN_irq() {
     PWR_BTN_event = true;
+    wakeLoopFromISR();
     }
     
-    void updateBattState() {
+    // ------------------ Power Service ------------------
+    // Battery, charger and OTG state are sampled by a low priority task every
+    // POWER_SAMPLE_MS instead of on every loop pass. Readers take the shared
+    // snapshot; state changes are flagged in an event group.
+    static portMUX_TYPE       snapshotLock = portMUX_INITIALIZER_UNLOCKED;
+    static PowerSnapshot      snapshot;
+    static EventGroupHandle_t eventGroup = NULL;
+    static TaskHandle_t       serviceTaskHandle = NULL;
+
+    // Rough Li-ion rest voltage to state of charge
+    static uint8_t voltageToPercent(float v) {
+    static const float curve[][2] = {
+        {3.30f, 0}, {3.60f, 10}, {3.70f, 25}, {3.80f, 45},
+        {3.90f, 60}, {4.00f, 75}, {4.10f, 90}, {4.20f, 100}
+    };
+    const size_t n = sizeof(curve) / sizeof(curve[0]);
+    if (v <= curve[0][0])     return 0;
+    if (v >= curve[n - 1][0]) return 100;
+    for (size_t i = 1; i < n; i++) {
+        if (v < curve[i][0]) {
+        const float t = (v - curve[i - 1][0]) / (curve[i][0] - curve[i - 1][0]);
+        return (uint8_t)(curve[i - 1][1] + t * (curve[i][1] - curve[i - 1][1]));
+        }
+    }
+    return 100;
+    }
 
+    static void sampleOnce(bool first) {
     // Read and scale voltage (add calibration offset if needed)
     float rawVoltage = (analogRead(BAT_SENS) * (3.3 / 4095.0) * 2) + 0.2;
 
-    // Moving average smoothing (adjust alpha for responsiveness)
+    // Moving average smoothing (alpha sized for the slower sample period)
     static float filteredVoltage = rawVoltage;
-    const float alpha = 0.1;  // Low-pass filter constant (lower = smoother, slower response)
+    const float alpha = 0.3;  // Low-pass filter constant (lower = smoother, slower response)
     filteredVoltage = alpha * rawVoltage + (1.0 - alpha) * filteredVoltage;
 
-    static float prevVoltage = 0.0;
-    static int prevBattState = -1;  // Ensure valid initial state
     const float threshold = 0.05;   // Hysteresis threshold
 
-    int newState = battState;
+    PowerSnapshot next = getPowerSnapshot();
+    next.voltage   = filteredVoltage;
+    next.percent   = voltageToPercent(filteredVoltage);
+    next.sampledAt = millis();
 
     // Charging state overrides everything
     MP2722::MP2722_ChargeStatus chg;
-    if (/*digitalRead(CHRG_SENS) == 1*/PowerSystem.getChargeStatus(chg) && (chg.code == 0b001 || chg.code == 0b010 || chg.code == 0b011 || chg.code == 0b100 || chg.code == 0b101)) {
-        newState = 5;
+    if (PowerSystem.getChargeStatus(chg)) {
+        next.chargeCode = chg.code;
+        next.charging   = (chg.code >= 0b001 && chg.code <= 0b101);
+    }
+
+    bool low, otg;
+    if (PowerSystem.getStatusFlags(low, otg)) {
+        next.batteryLow = low;
+        next.otgNeeded  = otg;
+    }
+
+    // With BATT_LOW_SHUTDOWN the low flag powers the device off, so it has
+    // to hold for BATT_LOW_SAMPLES samples in a row before it is acted on
+    static uint8_t lowSamples = 0;
+    if (next.batteryLow && !next.charging) {
+        if (lowSamples < BATT_LOW_SAMPLES) lowSamples++;
     } else {
-        // Check for low battery
-        bool low;
-        if (!PowerSystem.isBatteryLow(low)) {
-            if (low) {
-                OLED().oledWord("Battery Critial!");
-                delay(1000);
-
-                // Save current work
-                OLED().oledWord("Saving Work");
-                //pocketmage::file::saveFile();
-                String savePath = SD().getEditingFile();
-                if (savePath != "" && savePath != "-" && savePath != "/temp.txt" && fileLoaded) {
-                    if (!savePath.startsWith("/")) savePath = "/" + savePath;
-                    saveMarkdownFile(SD().getEditingFile());
-                }
-
-                // Put device to sleep
-                deepSleep(false);
-            }
-        }
+        lowSamples = 0;
+    }
 
+    const int prevBattState = next.battState;
+    if (next.charging) {
+        next.battState = 5;
+    } else {
         // Normal battery voltage thresholds with hysteresis
         if (filteredVoltage > 4.1 || (prevBattState == 4 && filteredVoltage > 4.1 - threshold)) {
-        newState = 4;
+        next.battState = 4;
         } else if (filteredVoltage > 3.9 || (prevBattState == 3 && filteredVoltage > 3.9 - threshold)) {
-        newState = 3;
+        next.battState = 3;
         } else if (filteredVoltage > 3.8 || (prevBattState == 2 && filteredVoltage > 3.8 - threshold)) {
-        newState = 2;
+        next.battState = 2;
         } else if (filteredVoltage > 3.7 || (prevBattState == 1 && filteredVoltage > 3.7 - threshold)) {
-        newState = 1;
-        } else if (filteredVoltage <= 3.7) {
-        newState = 0;
+        next.battState = 1;
+        } else {
+        next.battState = 0;
         }
     }
 
-    if (newState != battState) {
-        battState = newState;
-        prevBattState = newState;
-        // newState = true;
+    const PowerSnapshot prev = getPowerSnapshot();
+    EventBits_t events = 0;
+    if (first || next.battState != prev.battState)                       events |= POWER_EVT_BATT;
+    if (first || next.charging != prev.charging || next.chargeCode != prev.chargeCode) events |= POWER_EVT_CHARGE;
+    if (first || next.otgNeeded != prev.otgNeeded)                       events |= POWER_EVT_OTG;
+    if (BATT_LOW_SHUTDOWN && lowSamples >= BATT_LOW_SAMPLES)             events |= POWER_EVT_LOW;
+
+    portENTER_CRITICAL(&snapshotLock);
+    snapshot = next;
+    portEXIT_CRITICAL(&snapshotLock);
+    battState = next.battState;
+
+    if (events) {
+        xEventGroupSetBits(eventGroup, events);
+        wakeLoop();
+        if (DEBUG_VERBOSE && (events & (POWER_EVT_CHARGE | POWER_EVT_OTG))) PowerSystem.printDiagnostics();
+    }
+    }
+
+    static void powerServiceTask(void* parameter) {
+    const TickType_t period = pdMS_TO_TICKS((uint32_t)(uintptr_t)parameter);
+    TickType_t lastWake = xTaskGetTickCount();
+    sampleOnce(true);
+    for (;;) {
+        vTaskDelayUntil(&lastWake, period);
+        sampleOnce(false);
+    }
+    }
+
+    void startPowerService(uint32_t periodMs) {
+    if (serviceTaskHandle != NULL) return;
+    if (eventGroup == NULL) eventGroup = xEventGroupCreate();
+
+    xTaskCreatePinnedToCore(
+        powerServiceTask,              // Function name
+        "powerServiceTask",            // Task name
+        3072,                          // Stack size
+        (void*)(uintptr_t)periodMs,    // Parameters
+        1,                             // Priority
+        &serviceTaskHandle,            // Task handle
+        0                              // Core ID
+    );
+    }
+
+    PowerSnapshot getPowerSnapshot() {
+    portENTER_CRITICAL(&snapshotLock);
+    PowerSnapshot copy = snapshot;
+    portEXIT_CRITICAL(&snapshotLock);
+    return copy;
+    }
+
+    EventGroupHandle_t powerEvents() { return eventGroup; }
+
+    uint32_t takePowerEvents(uint32_t mask) {
+    if (eventGroup == NULL) return 0;
+    return xEventGroupClearBits(eventGroup, mask) & mask;
+    }
+
+    // ------------------ Loop Wakeups ------------------
+    // loop() and the E-Ink task block on a task notification instead of a
+    // fixed 50ms delay. Right after input they keep a LOOP_ACTIVE_MS cadence
+    // (key cooldowns, redraws); otherwise they wait up to LOOP_IDLE_MS so
+    // automatic light sleep can kick in between passes.
+    static TaskHandle_t   loopTaskHandle   = NULL;
+    static volatile unsigned long lastWakeEvent = 0;
+    static portMUX_TYPE   sleepStatsLock   = portMUX_INITIALIZER_UNLOCKED;
+    static uint32_t       wakeupCount      = 0;
+    static uint64_t       blockedUs        = 0;
+    static uint32_t       printedWakeups   = 0;
+    static uint64_t       printedBlockedUs = 0;
+    static int64_t        printedAt        = 0;
+    static bool           lightSleepActive = false;
+    #if CONFIG_PM_ENABLE
+    static esp_pm_lock_handle_t noSleepLock = NULL;
+    static bool           noSleepHeld      = false;
+    // Held by the loop and E-Ink tasks whenever they are not blocked, so
+    // DFS only drops the clock between passes and the setCpuFrequencyMhz()
+    // boosts inside a pass are not undone by esp_pm mid-operation
+    static esp_pm_lock_handle_t cpuMaxLock = NULL;
+    #endif
+    static bool           loopHoldsMax     = false;
+    static bool           einkHoldsMax     = false;
+
+    void wakeLoop() {
+    lastWakeEvent = millis();
+    if (loopTaskHandle)        xTaskNotifyGive(loopTaskHandle);
+    if (einkHandlerTaskHandle) xTaskNotifyGive(einkHandlerTaskHandle);
+    }
+
+    void IRAM_ATTR wakeLoopFromISR() {
+    BaseType_t woken = pdFALSE;
+    if (loopTaskHandle)        vTaskNotifyGiveFromISR(loopTaskHandle, &woken);
+    if (einkHandlerTaskHandle) vTaskNotifyGiveFromISR(einkHandlerTaskHandle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+    }
+
+    static void waitForWork(bool& holdsMax) {
+    #if CONFIG_PM_ENABLE
+    if (holdsMax) {
+        esp_pm_lock_release(cpuMaxLock);
+        holdsMax = false;
+    }
+    #endif
+
+    const bool active = (millis() - lastWakeEvent) < LOOP_ACTIVE_WINDOW_MS;
+    const int64_t start = esp_timer_get_time();
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(active ? LOOP_ACTIVE_MS : LOOP_IDLE_MS)) > 0)
+        lastWakeEvent = millis();
+    const int64_t blocked = esp_timer_get_time() - start;
+
+    #if CONFIG_PM_ENABLE
+    if (cpuMaxLock) {
+        esp_pm_lock_acquire(cpuMaxLock);
+        holdsMax = true;
+    }
+    #endif
+
+    portENTER_CRITICAL(&sleepStatsLock);
+    wakeupCount++;
+    blockedUs += blocked;
+    portEXIT_CRITICAL(&sleepStatsLock);
+    }
+
+    void waitForLoopWork() {
+    if (!loopTaskHandle) loopTaskHandle = xTaskGetCurrentTaskHandle();
+
+    #if CONFIG_PM_ENABLE
+    // USB (host keyboard, MSC, CDC serial) does not survive light sleep
+    const bool holdAwake = !SAVE_POWER || mscEnabled || sinkEnabled;
+    if (noSleepLock && holdAwake != noSleepHeld) {
+        if (holdAwake) esp_pm_lock_acquire(noSleepLock);
+        else           esp_pm_lock_release(noSleepLock);
+        noSleepHeld = holdAwake;
+    }
+    #endif
+
+    waitForWork(loopHoldsMax);
+    }
+
+    void waitForEinkWork() {
+    waitForWork(einkHoldsMax);
     }
 
-    prevVoltage = filteredVoltage;
+    // Dynamic frequency scaling with automatic light sleep. Needs PM support
+    // in the IDF build; without tickless idle it falls back to DFS only.
+    void configureLightSleep() {
+    #if CONFIG_PM_ENABLE
+    const int maxFreq = getCpuFrequencyMhz();
+    esp_pm_config_esp32s3_t pm = {};
+    pm.max_freq_mhz       = maxFreq;
+    pm.min_freq_mhz       = min(maxFreq, 40);
+    pm.light_sleep_enable = true;
+
+    esp_err_t err = esp_pm_configure(&pm);
+    if (err == ESP_ERR_NOT_SUPPORTED) {
+        pm.light_sleep_enable = false;
+        err = esp_pm_configure(&pm);
+    }
+    lightSleepActive = (err == ESP_OK) && pm.light_sleep_enable;
+    if (err != ESP_OK) ESP_LOGW(TAG, "esp_pm_configure failed: %s", esp_err_to_name(err));
+
+    if (err == ESP_OK && !cpuMaxLock &&
+        esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "work", &cpuMaxLock) == ESP_OK) {
+        // Called from setup() on the loop task, which is busy until its first wait
+        esp_pm_lock_acquire(cpuMaxLock);
+        loopHoldsMax = true;
+    }
+
+    if (lightSleepActive && !noSleepLock) {
+        // Keypad and power button wake the chip from light sleep
+        gpio_wakeup_enable((gpio_num_t)KB_IRQ, GPIO_INTR_LOW_LEVEL);
+        gpio_wakeup_enable((gpio_num_t)PWR_BTN, GPIO_INTR_LOW_LEVEL);
+        if (TOUCH_IRQ >= 0) gpio_wakeup_enable((gpio_num_t)TOUCH_IRQ, GPIO_INTR_LOW_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+        esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "usb", &noSleepLock);
+    }
+    #endif
+    }
+
+    void printSleepStats() {
+    const int64_t now = esp_timer_get_time();
+    const int64_t elapsed = now - printedAt;
+    if (elapsed <= 0) return;
+
+    portENTER_CRITICAL(&sleepStatsLock);
+    const uint32_t wakeups = wakeupCount;
+    const uint64_t blocked = blockedUs;
+    portEXIT_CRITICAL(&sleepStatsLock);
+
+    // Time both tasks spend blocked in waitForWork, out of 2x wall time.
+    // Light sleep can only happen inside it; actual sleep time is not measured.
+    ESP_LOGD(TAG, "WAKEUPS: %.1f/s, BLOCKED: %.1f%%, LIGHT_SLEEP: %d",
+        (wakeups - printedWakeups) * 1e6f / elapsed,
+        (blocked - printedBlockedUs) * 50.0f / elapsed,
+        (int)lightSleepActive);
+
+    printedWakeups   = wakeups;
+    printedBlockedUs = blocked;
+    printedAt        = now;
+    }
+
+    void updateBattState() {
+    // battState is kept current by the power service; only the low battery
+    // shutdown needs the main loop (SD and OLED access). POWER_EVT_LOW is
+    // only raised when BATT_LOW_SHUTDOWN is enabled.
+    if (!takePowerEvents(POWER_EVT_LOW)) return;
+
+    OLED().oledWord("Battery Critial!");
+    delay(1000);
+
+    // Save current work
+    OLED().oledWord("Saving Work");
+    //pocketmage::file::saveFile();
+    String savePath = SD().getEditingFile();
+    if (savePath != "" && savePath != "-" && savePath != "/temp.txt" && fileLoaded) {
+        if (!savePath.startsWith("/")) savePath = "/" + savePath;
+        saveMarkdownFile(savePath);
+    }
+
+    // Put device to sleep
+    deepSleep(false);
     }
     
     void loadState(bool changeState) {
@@ -875,7 +1297,7 @@ namespace pocketmage::power{
         else
         CurrentAppState = static_cast<AppState>(prefs.getInt("CurrentAppState", HOME));
 
-        keypad.flush();
+        KB().flush();
 
         // Initialize boot app if needed
         switch (CurrentAppState) {
@@ -913,7 +1335,7 @@ namespace pocketmage::power{
 
 namespace pocketmage::debug{
     void printDebug() {
-    DateTime now = CLOCK().nowDT();
+    DateTime now = CLOCK().cachedNow();
     if (now.second() != prevSec) {
     prevSec = now.second();
     float batteryVoltage = (analogRead(BAT_SENS) * (3.3 / 4095.0) * 2) + 0.2;
@@ -927,6 +1349,11 @@ namespace pocketmage::debug{
     // Display system time
     ESP_LOGD(TAG, "SYSTEM_CLOCK: %d/%d/%d (%s) %d:%d:%d", now.month(), now.day(), now.year(),
         daysOfTheWeek[now.dayOfTheWeek()], now.hour(), now.minute(), now.second());
+
+    // Bus usage per device, OLED frames, loop wakeups and idle time
+    I2C().printStats();
+    OLED().printStats();
+    pocketmage::power::printSleepStats();
     }
 }
 }    // namespace pocketmage::debug
@@ -935,19 +1362,38 @@ namespace pocketmage::debug{
 volatile bool newLineAdded = true;           // New line added in TXT
 std::vector<String> allLines;         // All lines in TXT
 
+// Per-character advance widths for the current e-ink font, so wrapping
+// can keep a running line width instead of re-measuring the whole line
+static void loadAdvances(uint8_t adv[256]) {
+const GFXfont* font = EINK().getCurrentFont();
+for (int c = 0; c < 256; c++) {
+    if (font && font->glyph) {
+    adv[c] = (c >= font->first && c <= font->last)
+                 ? pgm_read_byte(&font->glyph[c - font->first].xAdvance)
+                 : 0;
+    } else {
+    adv[c] = (c >= 32 && c <= 126) ? EINK().getEinkTextWidth(String((char)c)) : 0;
+    }
+}
+}
+
+static uint16_t advanceWidth(const uint8_t adv[256], const String& s, size_t from = 0) {
+uint16_t width = 0;
+for (size_t i = from; i < s.length(); i++) width += adv[(uint8_t)s[i]];
+return width;
+}
+
 String vectorToString() {
 String result;
 EINK().setTXTFont(EINK().getCurrentFont());
+uint8_t adv[256];
+loadAdvances(adv);
 
 for (size_t i = 0; i < allLines.size(); i++) {
     result += allLines[i];
 
-    int16_t x1, y1;
-    uint16_t charWidth, charHeight;
-    display.getTextBounds(allLines[i], 0, 0, &x1, &y1, &charWidth, &charHeight);
-
     // Add newline only if the line doesn't fully use the available space
-    if (charWidth < display.width() && i < allLines.size() - 1) {
+    if (advanceWidth(adv, allLines[i]) < display.width() && i < allLines.size() - 1) {
     result += '\n';
     }
 }
@@ -959,37 +1405,39 @@ void stringToVector(String inputText) {
 EINK().setTXTFont(EINK().getCurrentFont());
 allLines.clear();
 String currentLine_;
+uint8_t adv[256];
+loadAdvances(adv);
+const uint16_t maxWidth = display.width() - 5;
+uint16_t lineWidth = 0;  // advance width of currentLine_
 
 for (size_t i = 0; i < inputText.length(); i++) {
     char c = inputText[i];
 
-    int16_t x1, y1;
-    uint16_t charWidth, charHeight;
-    display.getTextBounds(currentLine_, 0, 0, &x1, &y1, &charWidth, &charHeight);
-
     // Check if new line needed
-    if ((c == '\n' || charWidth >= display.width() - 5) && !currentLine_.isEmpty()) {
-    if (currentLine_.endsWith(" ")) {
-        allLines.push_back(currentLine_);
-        currentLine_ = "";
-    } else {
-        int lastSpace = currentLine_.lastIndexOf(' ');
-        if (lastSpace != -1) {
-        // Split line at last space
+    if (c == '\n' && !currentLine_.isEmpty()) {
+    allLines.push_back(currentLine_);
+    currentLine_ = "";
+    lineWidth = 0;
+    } else if (lineWidth >= maxWidth && !currentLine_.isEmpty()) {
+    int lastSpace = currentLine_.endsWith(" ") ? -1 : currentLine_.lastIndexOf(' ');
+    if (lastSpace != -1) {
+        // Split line at last space, carrying the partial word over
         String partialWord = currentLine_.substring(lastSpace + 1);
-        currentLine_ = currentLine_.substring(0, lastSpace);
+        currentLine_.remove(lastSpace);
         allLines.push_back(currentLine_);
-        currentLine_ = partialWord;  // Start new line with partial word
-        } else {
-        // No spaces, whole line is a single word
+        currentLine_ = partialWord;
+        lineWidth = advanceWidth(adv, currentLine_);
+    } else {
+        // Line ends in a space, or is a single word
         allLines.push_back(currentLine_);
         currentLine_ = "";
-        }
+        lineWidth = 0;
     }
     }
 
     if (c != '\n') {
     currentLine_ += c;
+    lineWidth += adv[(uint8_t)c];
     }
 }
 
@@ -1,5 +1,6 @@
 #include <pocketmage.h> 
 #include <Adafruit_MPR121.h>
+#include <Wire.h>
 
 Adafruit_MPR121 cap =  Adafruit_MPR121(); // Touch slider
 
@@ -11,107 +12,239 @@ class PocketmageEink;
 
 static constexpr const char* TAG = "TOUCH";
 
-// Setup for Touch Class
-void setupTouch(){
+// Kinetic scrolling, in pads and seconds
+static constexpr float TOUCH_MAX_JUMP   = 2.0f;   // ignore centroid jumps larger than this
+static constexpr float TOUCH_FLING_MIN  = 6.0f;   // release speed needed to coast (pads/s)
+static constexpr float TOUCH_COAST_MIN  = 1.5f;   // coasting stops below this speed (pads/s)
+static constexpr float TOUCH_FRICTION   = 20.0f;  // coasting deceleration (pads/s^2)
+static constexpr TickType_t TOUCH_POLL_TICKS = pdMS_TO_TICKS(50);  // idle poll without IRQ
+
+// MPR121 registers: touch status, then filtered data through baselines
+static constexpr uint8_t MPR121_STATUS     = 0x00;
+static constexpr uint8_t MPR121_FILT       = 0x04;
+static constexpr uint8_t MPR121_BASE       = 0x1E;
+static constexpr uint8_t SLIDER_PADS       = 9;
+static constexpr uint8_t MPR121_DATA_LEN   = MPR121_BASE + SLIDER_PADS - MPR121_FILT;
+
+void IRAM_ATTR TOUCH_irq_handler() { TOUCH().notifyFromISR(); }
+
+// Setup for Touch Class (failure is reported from the main task)
+bool setupTouch(){
   // MPR121 / SLIDER
+  I2CLease bus(I2C_DEV_TOUCH);
   if (!cap.begin(MPR121_ADDR)) {
     ESP_LOGE(TAG, "TouchPad Failed");
-    OLED().oledWord("TouchPad Failed");
-    delay(1000);
+    return false;
   }
   cap.setAutoconfig(true);
+  TOUCH().startTask(TOUCH_IRQ);
+  return true;
+}
+
+void reportTouchFailed() {
+  OLED().oledWord("TouchPad Failed");
+  delay(1000);
 }
 
 // Access for other apps
 PocketmageTOUCH& TOUCH() { return pm_touch; }
 
+// ===================== touch task =====================
+void PocketmageTOUCH::startTask(int irqPin) {
+  irqWired_ = irqPin >= 0;
+
+  xTaskCreatePinnedToCore(
+    taskEntry,               // Function name
+    "touchTask",             // Task name
+    3072,                    // Stack size
+    this,                    // Parameters
+    2,                       // Priority
+    &taskHandle_,            // Task handle
+    0                        // Core ID
+  );
+
+  if (irqWired_) {
+    pinMode(irqPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(irqPin), TOUCH_irq_handler, FALLING);
+  }
+}
 
+void IRAM_ATTR PocketmageTOUCH::notifyFromISR() {
+  if (!taskHandle_) return;
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(taskHandle_, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
 
-void PocketmageTOUCH::updateScrollFromTouch() {
-  uint16_t touched = cap_.touched();
-  int newTouch = -1;
-
-  for (int i = 0; i < 9; ++i)
-    if (touched & (1 << i)) { newTouch = i; break; }
-
-  unsigned long now = millis();
-
-  if (newTouch != -1) {
-    if (lastTouch_ != -1) {
-      int d = abs(newTouch - lastTouch_);
-      if (d <= 2) {
-        int maxScroll = max(0, (int)allLines.size() - EINK().maxLines());
-        if (newTouch > lastTouch_) {
-          dynamicScroll_ = min((long)(dynamicScroll_ + 1), (long)maxScroll);
-        } else if (newTouch < lastTouch_) {
-          dynamicScroll_ = max((long)(dynamicScroll_ - 1), 0L);
-        }
-      }
-    }
-    lastTouch_ = newTouch;
-    lastTouchTime_ = now;
-  } else if (lastTouch_ != -1 && (now - lastTouchTime_ > TOUCH_TIMEOUT_MS)) {
-    lastTouch_ = -1;
-    if (prev_dynamicScroll_ != dynamicScroll_)
-      newLineAdded = true;
-  }
+void PocketmageTOUCH::taskEntry(void* arg) {
+  static_cast<PocketmageTOUCH*>(arg)->taskLoop();
 }
 
-bool PocketmageTOUCH::updateScroll(int maxScroll,ulong& lineScroll) {
+// Returns the delta-weighted centroid of the touched pads, or false when
+// nothing is touched. Idle polls read only the 2 status bytes (which also
+// releases the IRQ line); filtered data and baselines are fetched in one
+// more transaction only while a pad is touched.
+bool PocketmageTOUCH::readSlider(float& pos) {
+  uint8_t status[2];
+  if (!I2C().readRegs(I2C_DEV_TOUCH, MPR121_ADDR, MPR121_STATUS, status, sizeof(status))) return false;
+
+  const uint16_t touched = (status[0] | (status[1] << 8)) & ((1 << SLIDER_PADS) - 1);
+  if (!touched) return false;
+
+  uint8_t data[MPR121_DATA_LEN];
+  if (!I2C().readRegs(I2C_DEV_TOUCH, MPR121_ADDR, MPR121_FILT, data, sizeof(data))) return false;
+  const uint8_t* filt = data;
+  const uint8_t* base = data + (MPR121_BASE - MPR121_FILT);
+
+  int32_t weightSum = 0;
+  int32_t posSum    = 0;
+  for (uint8_t i = 0; i < SLIDER_PADS; i++) {
+    if (!(touched & (1 << i))) continue;
+    const int16_t filtered = filt[2*i] | (filt[2*i + 1] << 8);
+    const int16_t baseline = base[i] << 2;
+    const int32_t weight   = max(1, baseline - filtered);
+    weightSum += weight;
+    posSum    += weight * i;
+  }
+  pos = (float)posSum / weightSum;
+  return true;
+}
 
-  static int lastTouchPos = -1;
-  static unsigned long lastTouchTime = 0;
-  static int prev_lineScroll = 0;
-  bool updateScreen = false;
+void PocketmageTOUCH::taskLoop() {
+  bool  down      = false;
+  float lastPos   = 0.0f;
+  float accum     = 0.0f;   // fractional pads not yet emitted
+  float velocity  = 0.0f;   // pads per second
+  unsigned long lastSample = millis();
+
+  for (;;) {
+    const bool coasting = !down && velocity != 0.0f;
+    bool sample = true;
+
+    if (down) {
+      vTaskDelay(pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+    } else if (coasting) {
+      // With the IRQ wired, only touch the bus again if the slider changes
+      const bool notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+      sample = notified || !irqWired_;
+    } else {
+      ulTaskNotifyTake(pdTRUE, irqWired_ ? portMAX_DELAY : TOUCH_POLL_TICKS);
+    }
 
-  uint16_t touched = cap_.touched();  // Read touch state
-  int touchPos = -1;
+    const unsigned long now = millis();
+    const float dt = min(now - lastSample, 100UL) / 1000.0f;
+    lastSample = now;
+
+    float pos = 0.0f;
+    const bool touched = sample && readSlider(pos);
+
+    if (touched && !down) {
+      // New touch: stops any coast
+      down     = true;
+      lastPos  = pos;
+      accum    = 0.0f;
+      velocity = 0.0f;
+      pushSteps(0, lroundf(pos));
+      continue;
+    }
 
-  // Find the first active touch point (lowest index first)
-  for (int i = 0; i < 9; i++) {
-    if (touched & (1 << i)) {
-      touchPos = i;
+    if (touched) {
+      const float d = pos - lastPos;
+      lastPos = pos;
+      if (fabsf(d) > TOUCH_MAX_JUMP) continue;
+      if (dt > 0.0f) velocity = 0.6f * velocity + 0.4f * (d / dt);
+      accum += d;
+    } else if (down && sample) {
+      // Release: fling or stop
+      down = false;
+      if (fabsf(velocity) < TOUCH_FLING_MIN) velocity = 0.0f;
+    } else if (coasting) {
+      accum += velocity * dt;
+      const float slow = TOUCH_FRICTION * dt;
+      if (fabsf(velocity) <= slow + TOUCH_COAST_MIN) velocity = 0.0f;
+      else velocity += (velocity > 0.0f) ? -slow : slow;
+    } else {
+      continue;
+    }
 
-      ESP_LOGI(tag, "Prev pad: %d\tTouched pad: %d\n", lastTouchPos,
-               touchPos);  // TODO(logging): come up with more descriptive tags
+    const int32_t steps = (int32_t)accum;
+    accum -= steps;
 
-      break;
+    if (down || velocity != 0.0f) {
+      pushSteps(steps, lroundf(lastPos));
+    } else {
+      if (steps) pushSteps(steps, lroundf(lastPos));
+      portENTER_CRITICAL(&lock_);
+      moving_ = false;
+      portEXIT_CRITICAL(&lock_);
     }
   }
+}
 
-  unsigned long currentTime = millis();
+void PocketmageTOUCH::pushSteps(int32_t steps, int pad) {
+  portENTER_CRITICAL(&lock_);
+  pendingSteps_ += steps;
+  touchedPad_    = constrain(pad, 0, SLIDER_PADS - 1);
+  moving_        = true;
+  lastActivity_  = millis();
+  portEXIT_CRITICAL(&lock_);
+  pocketmage::power::wakeLoop();
+}
+
+int32_t PocketmageTOUCH::takeSteps(bool& moving, int& pad, unsigned long& lastActivity) {
+  portENTER_CRITICAL(&lock_);
+  const int32_t steps = pendingSteps_;
+  pendingSteps_ = 0;
+  moving        = moving_;
+  pad           = touchedPad_;
+  touchedPad_   = -1;
+  lastActivity  = lastActivity_;
+  portEXIT_CRITICAL(&lock_);
+  return steps;
+}
 
-  if (touchPos != -1) {  // If a touch is detected
-    ESP_LOGI(tag, "Touch detected\n");
+// ===================== public functions =====================
+void PocketmageTOUCH::updateScrollFromTouch() {
+  bool moving; int pad; unsigned long lastActivity;
+  const int32_t steps = takeSteps(moving, pad, lastActivity);
 
-    if (lastTouchPos != -1) {  // Compare with previous touch
-      int touchDelta = abs(touchPos - lastTouchPos);
-      if (touchDelta <= 2) {  // Ignore large jumps
+  if (steps != 0) {
+    int maxScroll = max(0, (int)allLines.size() - EINK().maxLines());
+    dynamicScroll_ = constrain((long)(dynamicScroll_ + steps), 0L, (long)maxScroll);
+  }
 
-        // REVERSED SCROLL DIRECTION:
-        if (touchPos < lastTouchPos && lineScroll < maxScroll) {
-          prev_lineScroll = lineScroll;
-          lineScroll++;
-        } else if (touchPos > lastTouchPos && lineScroll > 0) {
-          prev_lineScroll = lineScroll;
-          lineScroll--;
-        }
-      }
-    }
+  if (pad != -1) {
+    lastTouch_ = pad;
+    lastTouchTime_ = lastActivity;
+  } else if (lastTouch_ != -1 && !moving && (millis() - lastActivity > TOUCH_TIMEOUT_MS)) {
+    lastTouch_ = -1;
+    if (prev_dynamicScroll_ != dynamicScroll_)
+      newLineAdded = true;
+  }
+}
+
+bool PocketmageTOUCH::updateScroll(int maxScroll,ulong& lineScroll) {
+  static ulong scrollAtTouch = 0;
+  bool updateScreen = false;
 
-    lastTouchPos = touchPos;      // update tracked touch
-    lastTouch_ = touchPos;         // <--- update UI flag
-    lastTouchTime = currentTime;  // reset timeout
-  } else if (lastTouchPos != -1 && (currentTime - lastTouchTime > TOUCH_TIMEOUT_MS)) {
-    // Timeout: reset both
-    lastTouchPos = -1;
-    lastTouch_ = -1;  // <--- reset UI flag
+  bool moving; int pad; unsigned long lastActivity;
+  const int32_t steps = takeSteps(moving, pad, lastActivity);
 
-    if (prev_lineScroll != lineScroll) {
-      updateScreen = true;
-    }
+  if (pad != -1 && lastTouch_ == -1) scrollAtTouch = lineScroll;
 
-    prev_lineScroll = lineScroll;
+  if (steps != 0) {
+    // REVERSED SCROLL DIRECTION:
+    long next = (long)lineScroll - steps;
+    if (steps < 0 && next > maxScroll) next = max((long)lineScroll, (long)maxScroll);
+    lineScroll = max(next, 0L);
+  }
+
+  if (pad != -1) {
+    lastTouch_ = pad;  // <--- update UI flag
+    lastTouchTime_ = lastActivity;
+  } else if (lastTouch_ != -1 && !moving && (millis() - lastActivity > TOUCH_TIMEOUT_MS)) {
+    lastTouch_ = -1;   // <--- reset UI flag
+    updateScreen = (lineScroll != scrollAtTouch);
   }
   return updateScreen;
-}
\ No newline at end of file
+}
@@ -313,7 +313,7 @@ void processKB_ASTRALUAAPP() {
         oledInput = oledInput.substr(oledInput.length() - 21);
       }
       u8g2.drawStr(0, 24, oledInput.c_str());
-      u8g2.sendBuffer();
+      OLED().sendBuffer();
     }
     return;
   }
@@ -354,7 +354,7 @@ void processKB_ASTRALUAAPP() {
     oledInput = oledInput.substr(oledInput.length() - 21);
   }
   u8g2.drawStr(0, 24, oledInput.c_str());
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ===================== E-INK DISPLAY =====================
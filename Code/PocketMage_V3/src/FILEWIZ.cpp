@@ -315,9 +315,9 @@ void einkHandler_FILEWIZ() {
         display.drawBitmap(0, 0, fileWizardallArray[0], 320, 218, GxEPD_BLACK);
 
         // DRAW FILE LIST
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < MAX_FILES; i++) {
           display.setCursor(30, 54+(17*i));
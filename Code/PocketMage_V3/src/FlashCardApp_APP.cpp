@@ -476,7 +476,7 @@ void processKB_FLASHCARDAPP() {
       u8g2.drawStr(0, 12, "Statistics");
       break;
   }
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ===================== E-INK DISPLAY =====================
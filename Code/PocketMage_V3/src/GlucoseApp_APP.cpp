@@ -537,7 +537,7 @@ void processKB_GLUCOSEAPP() {
       u8g2.drawStr(0, 12, (String(summaryDays) + "-day Summary").c_str());
       break;
   }
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ===================== E-INK DISPLAY =====================
@@ -22,9 +22,9 @@ void commandSelect(String command) {
   if (command.startsWith("-")) {
     command = removeChar(command, ' ');
     command = removeChar(command, '-');
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     listDir(SD_MMC, "/");
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     for (uint8_t i = 0; i < (sizeof(filesList) / sizeof(filesList[0])); i++) {
       String lowerFileName = filesList[i]; 
@@ -44,9 +44,9 @@ void commandSelect(String command) {
   if (command.startsWith("/")) {
     command = removeChar(command, ' ');
     command = removeChar(command, '/');
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     listDir(SD_MMC, "/");
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     for (uint8_t i = 0; i < (sizeof(filesList) / sizeof(filesList[0])); i++) {
       String lowerFileName = filesList[i]; 
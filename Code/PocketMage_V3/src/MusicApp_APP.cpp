@@ -345,7 +345,7 @@ void processKB_MUSICAPP() {
       }
       break;
   }
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ===================== E-INK DISPLAY =====================
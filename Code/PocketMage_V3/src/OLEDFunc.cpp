@@ -22,14 +22,14 @@ void oledWord(String word, bool allowLarge, bool showInfo) {
     /*u8g2.setFont(u8g2_font_ncenB24_tr);
     if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
       u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+12,word.c_str());
-      u8g2.sendBuffer();
+      OLED().sendBuffer();
       return;
     }*/
 
     u8g2.setFont(u8g2_font_ncenB18_tr);
     if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
       u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+9,word.c_str());
-      u8g2.sendBuffer();
+      OLED().sendBuffer();
       return;
     }
   }
@@ -37,33 +37,33 @@ void oledWord(String word, bool allowLarge, bool showInfo) {
   u8g2.setFont(u8g2_font_ncenB14_tr);
   if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
     u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+7,word.c_str());
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
     return;
   }
 
   u8g2.setFont(u8g2_font_ncenB12_tr);
   if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
     u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+6,word.c_str());
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
     return;
   }
 
   u8g2.setFont(u8g2_font_ncenB10_tr);
   if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
     u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+5,word.c_str());
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
     return;
   }
 
   u8g2.setFont(u8g2_font_ncenB08_tr);
   if (u8g2.getStrWidth(word.c_str()) < u8g2.getDisplayWidth()) {
     u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()))/2,16+4,word.c_str());
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
     return;
   }
   else {
     u8g2.drawStr(u8g2.getDisplayWidth() - u8g2.getStrWidth(word.c_str()),16+4,word.c_str());
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
     return;
   }
   
@@ -129,7 +129,7 @@ void oledLine(String line, bool doProgressBar, String bottomMsg) {
     u8g2.drawStr(u8g2.getDisplayWidth()-8-u8g2.getStrWidth(line.c_str()),20,line.c_str());
   }
 
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 void infoBar() {
@@ -238,5 +238,5 @@ void oledScroll() {
   }
 
   // SEND BUFFER 
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
\ No newline at end of file
@@ -416,7 +416,7 @@ void drawProgressBar(uint8_t progress) {
   u8g2.drawStr((u8g2.getDisplayWidth() - u8g2.getStrWidth(progressText.c_str()))/2,
                u8g2.getDisplayHeight()-3,progressText.c_str());
 
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ---------- Operations ----------
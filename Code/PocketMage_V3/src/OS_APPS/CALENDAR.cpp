@@ -45,9 +45,15 @@ void updateEventArray() {
   setCpuFrequencyMhz(240);
   delay(50);
 
+  // A save that failed after removing events.txt leaves the only copy in the temp file
+  if (!SD_MMC.exists("/sys/events.txt") && SD_MMC.exists("/sys/events.txt.tmp"))
+    SD_MMC.rename("/sys/events.txt.tmp", "/sys/events.txt");
+
   File file = SD_MMC.open("/sys/events.txt", "r"); // Open the text file in read mode
   if (!file) {
     ESP_LOGE(TAG, "Failed to open file for reading: %s", file.path().c_str()); // .c_str() needed for desktop emulator compatibility
+    if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
+    SDActive = false;
     return;
   }
 
@@ -93,20 +99,82 @@ void sortEventsByDate(std::vector<std::vector<String>> &calendarEvents) {
   });
 }
 
+// Rewrite events.txt in one buffered pass to a temp file, then swap it in
 void updateEventsFile() {
+  static const char* eventsPath = "/sys/events.txt";
+  static const char* tmpPath    = "/sys/events.txt.tmp";
+
+  if (SD().getNoSD()) {
+    OLED().oledWord("OP FAILED - No SD!");
+    delay(5000);
+    return;
+  }
+
   SDActive = true;
   setCpuFrequencyMhz(240);
-  delay(50);
-  // Clear the existing calendarEvents file first
-  pocketmage::file::delFile("/sys/events.txt");
+  const unsigned long start = millis();
 
-  // Iterate through the calendarEvents vector and append each task to the file
+  File file = SD_MMC.open(tmpPath, FILE_WRITE);
+  if (!file) {
+    ESP_LOGE(TAG, "Failed to open %s", tmpPath);
+    if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
+    SDActive = false;
+    return;
+  }
+
+  char buf[512];
+  size_t used = 0;
+  size_t fileSize = 0;
+  int charCount = 0;
+  bool ok = true;
+
+  auto put = [&](const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      if (s[i] >= 32 && s[i] <= 126) charCount++;
+      buf[used++] = s[i];
+      if (used == sizeof(buf)) {
+        if (file.write((const uint8_t*)buf, used) != used) ok = false;
+        used = 0;
+      }
+    }
+    fileSize += n;
+  };
+
+  // One "name|date|time|duration|repeat|note" line per event
+  static constexpr size_t EVENT_FIELDS = 6;
   for (size_t i = 0; i < calendarEvents.size(); i++) {
-    // Create a string from the task's attributes with "|" delimiter
-    String eventInfo = calendarEvents[i][0] + "|" + calendarEvents[i][1] + "|" + calendarEvents[i][2] + "|" + calendarEvents[i][3]+ "|" + calendarEvents[i][4]+ "|" + calendarEvents[i][5];
-    
-    // Append the task info to the file
-    pocketmage::file::appendToFile("/sys/events.txt", eventInfo);
+    const std::vector<String>& ev = calendarEvents[i];
+    for (size_t f = 0; f < EVENT_FIELDS; f++) {
+      if (f > 0) put("|", 1);
+      if (f < ev.size()) put(ev[f].c_str(), ev[f].length());
+    }
+    put("\r\n", 2);
+  }
+  if (used > 0 && file.write((const uint8_t*)buf, used) != used) ok = false;
+  file.close();
+
+  // FAT cannot rename over an existing file, so remove the old one first.
+  // Once it is gone the temp file is the only copy and must be kept;
+  // updateEventArray() renames it back on the next load.
+  bool keepTmp = false;
+  if (ok) {
+    if (SD_MMC.exists(eventsPath) && !SD_MMC.remove(eventsPath)) {
+      ok = false;
+    }
+    else if (!SD_MMC.rename(tmpPath, eventsPath)) {
+      ok = false;
+      keepTmp = true;
+    }
+  }
+
+  if (ok) {
+    pocketmage::file::writeMetadata(eventsPath, fileSize, charCount);
+    ESP_LOGI(TAG, "Saved %u events (%u bytes) in %lu ms", (unsigned)calendarEvents.size(),
+             (unsigned)fileSize, millis() - start);
+  }
+  else {
+    ESP_LOGE(TAG, "Failed to write %s%s", eventsPath, keepTmp ? ", kept in .tmp" : "");
+    if (!keepTmp) SD_MMC.remove(tmpPath);
   }
 
   if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
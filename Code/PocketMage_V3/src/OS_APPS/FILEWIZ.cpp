@@ -200,7 +200,7 @@ String renderWizMini(String folder, int8_t scrollDelta) {
       break;
   }
 
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 
   return cachedFiles[scroll].address;
 }
@@ -314,6 +314,16 @@ String fileWizardMini(bool allowRecentSelect, String rootDir) {
   return "";
 }
 
+// Show copy progress on the OLED in 10% steps
+static void copyProgress(size_t copied, size_t total) {
+  static int shown = -10;
+  const int pct = total ? (int)(copied * 100 / total) : 100;
+  if (copied <= COPY_BUF_SIZE) shown = -10;  // new copy
+  if (pct / 10 == shown / 10) return;
+  shown = pct;
+  OLED().oledWord("Copying " + String(pct) + "%");
+}
+
 void processKB_FILEWIZ() {
   if (OLEDPowerSave) {
     u8g2.setPowerSave(0);
@@ -549,7 +559,7 @@ void processKB_FILEWIZ() {
         else if (inchar == 13) {      
           // Copy FILE                    
           String newName = "/" + currentWord + ".txt";
-          pocketmage::file::copyFile(SD().getWorkingFile(), newName);
+          pocketmage::file::copyFile(SD().getWorkingFile(), newName, true, copyProgress);
 
           // RETURN TO WIZ0
           refreshFiles = true;
@@ -597,9 +607,9 @@ void einkHandler_FILEWIZ() {
         // DRAW FILE LIST
 
         // TODO: Replace this with displaying the 10 most recent files from SDMMC_META
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         SD().listDir(SD_MMC, "/notes");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < MAX_FILES; i++) {
           display.setCursor(30, 54+(17*i));
@@ -31,9 +31,9 @@ void commandSelect(String command) {
   if (command.startsWith("-")) {
     command = removeChar(command, ' ');
     command = removeChar(command, '-');
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     SD().listDir(SD_MMC, "/");
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     for (uint8_t i = 0; i < MAX_FILES; i++) {
       String lowerFileName = SD().getFilesListIndex(i);
@@ -50,9 +50,9 @@ void commandSelect(String command) {
   if (command.startsWith("/")) {
     command = removeChar(command, ' ');
     command = removeChar(command, '/');
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     SD().listDir(SD_MMC, "/");
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     for (uint8_t i = 0; i < MAX_FILES; i++) {
       String lowerFileName = SD().getFilesListIndex(i);
@@ -352,7 +352,7 @@ void mageIdle(bool internalRefresh) {
 
   if (internalRefresh) {
     OLED().infoBar();
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
   }
 }
 
@@ -496,7 +496,7 @@ void einkHandler_HOME() {
             display.setFont(&FreeSerif9pt7b);
             // PRINT TASK NAME
             display.setCursor(151, 68 + (25 * i));
-            display.print(tasks[i][0].c_str());
+            display.print(tasks[i].name);
           }
         }
 
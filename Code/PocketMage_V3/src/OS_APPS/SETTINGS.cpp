@@ -30,7 +30,7 @@ void settingCommandSelect(String command) {
       int day   = datePart.substring(6, 8).toInt();
 
       DateTime now = CLOCK().nowDT();  // Preserve current time
-      CLOCK().getRTC().adjust(DateTime(year, month, day, now.hour(), now.minute(), now.second()));
+      CLOCK().adjust(DateTime(year, month, day, now.hour(), now.minute(), now.second()));
     } else {
       OLED().oledWord("Invalid format (use YYYYMMDD)");
       delay(2000);
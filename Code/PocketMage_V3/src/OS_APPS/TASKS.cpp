@@ -29,88 +29,191 @@ void TASKS_INIT() {
   newState = true;
 }
 
-void sortTasksByDueDate(std::vector<std::vector<String>> &tasks) {
-  std::sort(tasks.begin(), tasks.end(), [](const std::vector<String> &a, const std::vector<String> &b) {
-    return a[1] < b[1]; // Compare dueDate strings
-  });
+// ------------------ Task Store ------------------
+// tasks is kept sorted by due date (binary insertion on add/edit) and each
+// record remembers its line in tasks.txt, so edits rewrite one fixed-width
+// line instead of the whole file. Deleted lines are blanked and reused.
+#define TASKS_FILE "/sys/tasks.txt"
+
+// Longest record: name, '|', 8 digit date, '|', 3 digit priority, '|', flag, '\n'
+static_assert(TASK_NAME_MAX + 16 <= TASK_RECORD_LEN, "TASK_RECORD_LEN too short for a full record");
+
+static bool tasksLoaded = false;
+static bool tasksReadOnly = false;            // old file with names too long to convert
+static uint16_t taskSlotCount = 0;            // lines in tasks.txt
+static std::vector<uint16_t> freeTaskSlots;   // blanked lines
+
+static bool dueBefore(const TaskRecord& a, const TaskRecord& b) { return a.due < b.due; }
+
+void sortTasksByDueDate(std::vector<TaskRecord> &tasks) {
+  std::stable_sort(tasks.begin(), tasks.end(), dueBefore);
+}
+
+// Insert keeping due date order, after any tasks with the same date
+static size_t insertSorted(const TaskRecord& rec) {
+  auto it = std::upper_bound(tasks.begin(), tasks.end(), rec, dueBefore);
+  return tasks.insert(it, rec) - tasks.begin();
+}
+
+static void formatTaskRecord(const TaskRecord* rec, char* out) {
+  memset(out, ' ', TASK_RECORD_LEN - 1);
+  out[TASK_RECORD_LEN - 1] = '\n';
+  if (!rec) return;  // blank line = free slot
+  char buf[TASK_RECORD_LEN];
+  const int n = snprintf(buf, sizeof(buf), "%s|%08lu|%u|%u", rec->name, (unsigned long)rec->due,
+                         (unsigned)rec->priority, (unsigned)rec->completed);
+  memcpy(out, buf, min(n, TASK_RECORD_LEN - 1));
+}
+
+// Patch one line of tasks.txt (rec == nullptr blanks it)
+static void writeTaskSlot(uint16_t slot, const TaskRecord* rec) {
+  SDActive = true;
+  char line[TASK_RECORD_LEN];
+  formatTaskRecord(rec, line);
+
+  File file = SD_MMC.open(TASKS_FILE, "r+");
+  if (!file) file = SD_MMC.open(TASKS_FILE, FILE_WRITE);
+  if (file) {
+    file.seek((uint32_t)slot * TASK_RECORD_LEN);
+    file.write((const uint8_t*)line, TASK_RECORD_LEN);
+    file.close();
+  }
+  else ESP_LOGE(TAG, "Failed to open %s", TASKS_FILE);
+  SDActive = false;
+}
+
+static uint16_t takeTaskSlot() {
+  if (!freeTaskSlots.empty()) {
+    const uint16_t slot = freeTaskSlots.back();
+    freeTaskSlots.pop_back();
+    return slot;
+  }
+  return taskSlotCount++;
 }
 
+// Rewrite the whole file as fixed-width records (old files, or compaction)
 void updateTasksFile() {
   SDActive = true;
   setCpuFrequencyMhz(240);
-  delay(50);
-  // Clear the existing tasks file first
-  pocketmage::file::delFile("/sys/tasks.txt");
+  File file = SD_MMC.open(TASKS_FILE, FILE_WRITE);
+  if (!file) {
+    ESP_LOGE(TAG, "Failed to open %s", TASKS_FILE);
+    if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
+    SDActive = false;
+    return;
+  }
 
-  // Iterate through the tasks vector and append each task to the file
+  char line[TASK_RECORD_LEN];
   for (size_t i = 0; i < tasks.size(); i++) {
-    // Create a string from the task's attributes with "|" delimiter
-    String taskInfo = tasks[i][0] + "|" + tasks[i][1] + "|" + tasks[i][2] + "|" + tasks[i][3];
-    
-    // Append the task info to the file
-    pocketmage::file::appendToFile("/sys/tasks.txt", taskInfo);
+    tasks[i].slot = i;
+    formatTaskRecord(&tasks[i], line);
+    file.write((const uint8_t*)line, TASK_RECORD_LEN);
   }
+  file.close();
+  taskSlotCount = tasks.size();
+  freeTaskSlots.clear();
 
   if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
   SDActive = false;
 }
 
-void addTask(String taskName, String dueDate, String priority, String completed) {
-  String taskInfo = taskName+"|"+dueDate+"|"+priority+"|"+completed;
+bool addTask(String taskName, String dueDate, String priority, String completed) {
   updateTaskArray();
-  tasks.push_back({taskName, dueDate, priority, completed});
-  sortTasksByDueDate(tasks);
-  updateTasksFile();
+  if (tasksReadOnly) return false;
+
+  if (taskName.length() > TASK_NAME_MAX)
+    ESP_LOGW(TAG, "Task name cut to %d chars: %s", TASK_NAME_MAX, taskName.c_str());
+
+  TaskRecord rec = {};
+  strncpy(rec.name, taskName.c_str(), TASK_NAME_MAX);
+  for (char* c = rec.name; *c; c++) if (*c == '|' || *c == '\n') *c = ' ';
+  rec.due       = strtoul(dueDate.c_str(), nullptr, 10);
+  rec.priority  = priority.toInt();
+  rec.completed = completed.toInt() != 0;
+  rec.slot      = takeTaskSlot();
+
+  insertSorted(rec);
+  writeTaskSlot(rec.slot, &rec);
+  return true;
 }
 
 void updateTaskArray() {
+  if (tasksLoaded) return;  // in-memory list is kept in step with the file
+
   SDActive = true;
   setCpuFrequencyMhz(240);
-  delay(50);
-  File file = SD_MMC.open("/sys/tasks.txt", "r"); // Open the text file in read mode
+  File file = SD_MMC.open(TASKS_FILE, "r"); // Open the text file in read mode
   if (!file) {
-    ESP_LOGE(TAG, "Failed to open file to read: %s", file.path().c_str()); // .c_str() needed for desktop emulator compatibility
+    ESP_LOGE(TAG, "Failed to open file to read: %s", TASKS_FILE);
+    if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
+    SDActive = false;
     return;
   }
 
   tasks.clear(); // Clear the existing vector before loading the new data
+  freeTaskSlots.clear();
+  uint16_t slot = 0;
+  bool needsRewrite = false;
+  bool nameTooLong = false;
 
   // Loop through the file, line by line
   while (file.available()) {
     String line = file.readStringUntil('\n');  // Read a line from the file
+    if (line.length() != TASK_RECORD_LEN - 1) needsRewrite = true;
     line.trim();  // Remove any extra spaces or newlines
     
-    // Skip empty lines
+    // Blank lines are free slots
     if (line.length() == 0) {
+      freeTaskSlots.push_back(slot++);
       continue;
     }
 
     // Split the line into individual parts using the delimiter '|'
-    uint8_t delimiterPos1 = line.indexOf('|');
-    uint8_t delimiterPos2 = line.indexOf('|', delimiterPos1 + 1);
-    uint8_t delimiterPos3 = line.indexOf('|', delimiterPos2 + 1);
+    int delimiterPos1 = line.indexOf('|');
+    int delimiterPos2 = line.indexOf('|', delimiterPos1 + 1);
+    int delimiterPos3 = line.indexOf('|', delimiterPos2 + 1);
 
     // Extract task name, due date, priority, and completed status
-    String taskName  = line.substring(0, delimiterPos1);
-    String dueDate   = line.substring(delimiterPos1 + 1, delimiterPos2);
-    String priority  = line.substring(delimiterPos2 + 1, delimiterPos3);
-    String completed = line.substring(delimiterPos3 + 1);
+    TaskRecord rec = {};
+    const String name = line.substring(0, delimiterPos1);
+    if (name.length() > TASK_NAME_MAX) {
+      ESP_LOGW(TAG, "Task name longer than %d chars: %s", TASK_NAME_MAX, name.c_str());
+      nameTooLong = true;
+    }
+    strncpy(rec.name, name.c_str(), TASK_NAME_MAX);
+    rec.due       = line.substring(delimiterPos1 + 1, delimiterPos2).toInt();
+    rec.priority  = line.substring(delimiterPos2 + 1, delimiterPos3).toInt();
+    rec.completed = line.substring(delimiterPos3 + 1).toInt() != 0;
+    rec.slot      = slot++;
 
     // Add the task to the vector
-    tasks.push_back({taskName, dueDate, priority, completed});
+    tasks.push_back(rec);
   }
 
   file.close();  // Close the file
+  taskSlotCount = slot;
+  sortTasksByDueDate(tasks);
+  tasksLoaded = true;
+
+  // Older variable-length files are converted once. Converting would cut
+  // long names for good, so such a file is left as it is and the list is
+  // shown read-only until the names are shortened.
+  tasksReadOnly = needsRewrite && nameTooLong;
+  if (needsRewrite && !nameTooLong) updateTasksFile();
 
   if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
   SDActive = false;
 }
 
 
-void deleteTask(int index) {
+bool deleteTask(int index) {
+  if (tasksReadOnly) return false;
   if (index >= 0 && index < tasks.size()) {
+    writeTaskSlot(tasks[index].slot, nullptr);
+    freeTaskSlots.push_back(tasks[index].slot);
     tasks.erase(tasks.begin() + index);
   }
+  return true;
 }
 
 String convertDateFormat(String yyyymmdd) {
@@ -216,6 +319,12 @@ void processKB_TASKS() {
           // ENTER INFORMATION BASED ON STATE
           switch (newTaskState) {
             case 0: // ENTER TASK NAME
+              // NAME IS TOO LONG FOR A TASK RECORD
+              if (currentLine.length() > TASK_NAME_MAX) {
+                OLED().oledWord("Name Too Long");
+                delay(1000);
+                break;
+              }
               newTaskName = currentLine;
               currentLine = "";
               newTaskState = 1;
@@ -228,8 +337,10 @@ void processKB_TASKS() {
                 newTaskDueDate = currentLine;
 
                 // ADD NEW TASK
-                addTask(newTaskName, newTaskDueDate, "0", "0");
-                OLED().oledWord("New Task Added");
+                if (addTask(newTaskName, newTaskDueDate, "0", "0"))
+                  OLED().oledWord("New Task Added");
+                else
+                  OLED().oledWord("Task Names Too Long");
                 delay(1000);
 
                 // RETURN
@@ -290,8 +401,10 @@ void processKB_TASKS() {
 
           }
           else if (inchar == '3') { // DELETE TASK
-            deleteTask(selectedTask);
-            updateTasksFile();
+            if (!deleteTask(selectedTask)) {
+              OLED().oledWord("Task Names Too Long");
+              delay(1000);
+            }
             
             CurrentTasksState = TASKS0;
             EINK().forceSlowFullUpdate(true);
@@ -330,7 +443,6 @@ void einkHandler_TASKS() {
 
         // DRAW FILE LIST
         updateTaskArray();
-        sortTasksByDueDate(tasks);
 
         if (!tasks.empty()) {
           ESP_LOGV(TAG, "Printing Tasks");
@@ -341,13 +453,13 @@ void einkHandler_TASKS() {
             display.setFont(&FreeSerif9pt7b);
             // PRINT TASK NAME
             display.setCursor(29, 54 + (17 * i));
-            display.print(tasks[i][0].c_str());
+            display.print(tasks[i].name);
             // PRINT TASK DUE DATE
             display.setCursor(231, 54 + (17 * i));
-            display.print(convertDateFormat(tasks[i][1]).c_str());
+            display.print(convertDateFormat(String(tasks[i].due)).c_str());
 
             // Serial.print(tasks[i][0].c_str()); Serial.println(convertDateFormat(tasks[i][1]).c_str());
-            ESP_LOGI("TASKS", "%s, %s", tasks[i][0].c_str(), convertDateFormat(tasks[i][1]).c_str()); // TODO: Come up with some tag
+            ESP_LOGI("TASKS", "%s, %lu", tasks[i].name, (unsigned long)tasks[i].due); // TODO: Come up with some tag
           }
         }
         else EINK().drawStatusBar("No Tasks! Add New Task (N)");
@@ -367,7 +479,6 @@ void einkHandler_TASKS() {
 
           // DRAW FILE LIST
           updateTaskArray();
-          sortTasksByDueDate(tasks);
 
           if (!tasks.empty()) {
             ESP_LOGV(TAG, "Printing Tasks");
@@ -377,13 +488,13 @@ void einkHandler_TASKS() {
               display.setFont(&FreeSerif9pt7b);
               // PRINT TASK NAME
               display.setCursor(29, 54 + (17 * i));
-              display.print(tasks[i][0].c_str());
+              display.print(tasks[i].name);
               // PRINT TASK DUE DATE
               display.setCursor(231, 54 + (17 * i));
-              display.print(convertDateFormat(tasks[i][1]).c_str());
+              display.print(convertDateFormat(String(tasks[i].due)).c_str());
 
               // Serial.print(tasks[i][0].c_str()); Serial.println(convertDateFormat(tasks[i][1]).c_str());
-              ESP_LOGI("TASKS", "%s, %s", tasks[i][0].c_str(), convertDateFormat(tasks[i][1]).c_str()); // TODO: Come up with some tag
+              ESP_LOGI("TASKS", "%s, %lu", tasks[i].name, (unsigned long)tasks[i].due); // TODO: Come up with some tag
             }
           }
           switch (newTaskState) {
@@ -406,7 +517,7 @@ void einkHandler_TASKS() {
         display.fillScreen(GxEPD_WHITE);
 
         // DRAW APP
-        EINK().drawStatusBar("T:" + tasks[selectedTask][0]);
+        EINK().drawStatusBar("T:" + String(tasks[selectedTask].name));
         display.drawBitmap(0, 0, tasksApp1, 320, 218, GxEPD_BLACK);
 
         EINK().refresh();
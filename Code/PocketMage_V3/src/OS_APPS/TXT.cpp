@@ -341,7 +341,7 @@ void processKB_TXT_OLD() {
           //Load new file
           pocketmage::file::loadFile();
 
-          keypad.enableInterrupts();
+          KB().enableInterrupts();
 
           //Return to TXT_
           CurrentTXTState = TXT_;
@@ -521,9 +521,9 @@ void einkHandler_TXT_OLD() {
         display.fillRect(60,0,200,218,GxEPD_WHITE);
         display.drawBitmap(60,0,fileWizLiteallArray[0],200,218, GxEPD_BLACK);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         SD().listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < MAX_FILES; i++) {
           display.setCursor(88, 54+(17*i));
@@ -589,9 +589,9 @@ void einkHandler_TXT_OLD() {
         display.fillRect(60,0,200,218,GxEPD_WHITE);
         display.drawBitmap(60,0,fontfont0,200,218, GxEPD_BLACK);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         SD().listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < 7; i++) {
           display.setCursor(88, 54+(17*i));
@@ -54,6 +54,9 @@ TXTState_NEW CurrentTXTState_NEW = TXT_;
 
 #define TYPE_INTERFACE_TIMEOUT 5000  // ms
 #define SCROLL_LINE_OFFSET 3         // lines
+#define LOAD_CHUNK_SIZE 4096         // bytes read from SD per block
+#define LAYOUT_VIEWPORT_LINES 32     // display lines laid out for the e-ink view
+#define LAYOUT_PREVIEW_LINES 16      // display lines laid out for the OLED preview
 
 // ------------------ Fonts ------------------
 #define SPECIAL_PADDING 20      // Padding for lists, code blocks, quote blocks
@@ -197,17 +200,172 @@ struct LineObject {
   std::vector<wordObject> words;
 };
 
+// ------------------ Text Buffer ------------------
+// Gap buffer holding the raw markdown of one DocLine. The gap sits at the
+// cursor, so inserting or deleting there is O(1) amortized and only moving
+// the cursor costs (distance moved) bytes of memmove.
+class GapBuffer {
+ public:
+  GapBuffer() {}
+  GapBuffer(const char* s) { assign(s); }
+  GapBuffer(const String& s) { assign(s.c_str()); }
+
+  size_t length() const { return buf_.size() - gapLength(); }
+  size_t cursor() const { return gapStart_; }
+
+  char charAt(size_t i) const {
+    return (i < gapStart_) ? buf_[i] : buf_[i + gapLength()];
+  }
+
+  void assign(const char* s) { assign(s, s ? strlen(s) : 0); }
+
+  void assign(const char* s, size_t len) {
+    buf_.assign(s, s + len);
+    // Cursor at the end, empty gap: the next insert grows the buffer once.
+    gapStart_ = gapEnd_ = len;
+  }
+
+  void moveCursor(size_t pos) {
+    if (pos > length())
+      pos = length();
+    if (pos < gapStart_) {
+      size_t n = gapStart_ - pos;
+      memmove(&buf_[gapEnd_ - n], &buf_[pos], n);
+      gapStart_ -= n;
+      gapEnd_ -= n;
+    } else if (pos > gapStart_) {
+      size_t n = pos - gapStart_;
+      memmove(&buf_[gapStart_], &buf_[gapEnd_], n);
+      gapStart_ += n;
+      gapEnd_ += n;
+    }
+  }
+
+  void insert(char c) {
+    if (gapLength() == 0)
+      grow(1);
+    buf_[gapStart_++] = c;
+  }
+
+  void insert(const char* s, size_t n) {
+    if (n == 0)
+      return;
+    if (gapLength() < n)
+      grow(n);
+    memcpy(&buf_[gapStart_], s, n);
+    gapStart_ += n;
+  }
+
+  // Backspace: remove the character before the cursor
+  bool eraseBefore() {
+    if (gapStart_ == 0)
+      return false;
+    gapStart_--;
+    return true;
+  }
+
+  // Delete: remove the character after the cursor
+  bool eraseAfter() {
+    if (gapEnd_ == buf_.size())
+      return false;
+    gapEnd_++;
+    return true;
+  }
+
+  // Drop everything after the cursor and return it (used to split a line)
+  String cutTail() {
+    String tail = substring(gapStart_, length());
+    buf_.resize(gapStart_);
+    gapEnd_ = gapStart_;
+    return tail;
+  }
+
+  String substring(size_t start, size_t end) const {
+    String out;
+    if (end > length())
+      end = length();
+    if (start >= end)
+      return out;
+    out.reserve(end - start);
+    for (size_t i = start; i < end; i++)
+      out += charAt(i);
+    return out;
+  }
+
+  String toString() const { return substring(0, length()); }
+
+ private:
+  std::vector<char> buf_;
+  size_t gapStart_ = 0;
+  size_t gapEnd_ = 0;
+
+  size_t gapLength() const { return gapEnd_ - gapStart_; }
+
+  // Double the storage (at least enough for `need` more bytes) and move the
+  // text after the gap to the end of the new buffer.
+  void grow(size_t need) {
+    size_t tailLen = buf_.size() - gapEnd_;
+    size_t newSize = buf_.size() * 2;
+    if (newSize < buf_.size() + need + 16)
+      newSize = buf_.size() + need + 16;
+    buf_.resize(newSize);
+    if (tailLen > 0)
+      memmove(&buf_[newSize - tailLen], &buf_[gapEnd_], tailLen);
+    gapEnd_ = newSize - tailLen;
+  }
+};
+
 // Document Line object
 struct DocLine {
-  char style;                     // Markdown style: '1', '2', '3', '>', '-', etc.
-  String line;                    // Raw line content
+  char style = 'T';               // Markdown style: '1', '2', '3', '>', '-', etc.
+  GapBuffer text;                 // Raw line content (authoritative unless wordsEdited)
   std::vector<wordObject> words;  // Parsed words with formatting
   std::vector<LineObject> lines;  // split into line objects
-  ulong orderedListNumber;
+  ulong orderedListNumber = (ulong)-1;  // -1 unless style is 'L'
+  bool wordsEdited = false;       // words changed in append mode, text is stale
+  bool laidOut = false;           // words/lines are built, see layoutDisplayLines()
+  uint16_t estLines = 0;          // display line estimate used until laid out
+  ulong firstLineIndex = 0;       // display index of the first line
+  uint32_t fileOffset = 0;        // byte offset of this line in the loaded file
+
+  // Parse and wrap now
+  void layout() {
+    parseWords();
+    splitToLines();
+    laidOut = true;
+  }
+
+  // Display lines this DocLine occupies (estimated until laid out)
+  size_t displayLineCount() const { return laidOut ? lines.size() : estLines; }
+
+  // Guess the wrapped line count from the width of an 'n' in the body font
+  // for this style, without measuring any words.
+  void estimateLines() {
+    size_t len = text.length();
+    if (len == 0) {
+      estLines = 0;
+      return;
+    }
+    const GFXfont* font = pickFont(style, false, false);
+    uint8_t advance = font->yAdvance / 2;  // fonts without glyph tables
+    if (font->glyph)
+      advance = font->glyph[SPACEWIDTH_SYMBOL[0] - font->first].xAdvance;
+    size_t perLine = wrapWidth() / (advance ? advance : 1);
+    if (perLine == 0)
+      perLine = 1;
+    estLines = (len + perLine - 1) / perLine;
+  }
+
+  // Rebuild text from words if append mode has been editing the words directly
+  void syncText() {
+    if (wordsEdited)
+      compileToText();
+  }
 
   // Parse the line into wordObjects
   void parseWords() {
     words.clear();
+    String line = text.toString();
     int i = 0;
     while (i < line.length()) {
       if (line[i] == '*' && i + 1 < line.length() && line[i + 1] == '*') {
@@ -242,8 +400,8 @@ struct DocLine {
     }
   }
 
-  // Split word objects into lines
-  void splitToLines() {
+  // Usable text width for this style
+  uint16_t wrapWidth() const {
     uint16_t textWidth = display.width() - DISPLAY_WIDTH_BUFFER;
 
     if (style == '>' || style == 'C') {
@@ -252,6 +410,12 @@ struct DocLine {
     else if (style == '-' || style == 'L') {
       textWidth -= 2*SPECIAL_PADDING;
     }
+    return textWidth;
+  }
+
+  // Split word objects into lines
+  void splitToLines() {
+    uint16_t textWidth = wrapWidth();
 
     lines.clear();
     LineObject currentLine;
@@ -319,7 +483,8 @@ struct DocLine {
     }
 
     compiled.trim();
-    line = compiled;
+    text.assign(compiled.c_str());
+    wordsEdited = false;
   }
 
   int displayLine(int startX, int startY) {
@@ -331,6 +496,10 @@ struct DocLine {
 
     int cursorY = startY;
 
+    // Not laid out yet, so it is outside the viewport
+    if (!laidOut)
+      return 0;
+
     // Entire block is offscreen, do not render.
     if (!lines.empty() && lines.back().index < offsetLineScroll) {
       return 0;
@@ -468,6 +637,10 @@ struct DocLine {
 
     int cursorY = startY;
 
+    // Not laid out yet, so it is outside the preview
+    if (!laidOut)
+      return 0;
+
     // Entire block is offscreen, do not render.
     if (!lines.empty() && lines.back().index < lineScroll) {
       return 0;
@@ -603,17 +776,67 @@ struct DocLine {
 ulong editingLine_index = 0;
 std::vector<DocLine> docLines;
 
+// Index of the last DocLine, 0 for an empty document (never size() - 1 on empty)
+static ulong lastDocLineIndex() { return docLines.empty() ? 0 : docLines.size() - 1; }
+
+// ------------------ Save Tracking ------------------
+// DocLines before firstDirtyLine are unchanged since savedPath was loaded or
+// saved, and every clean line starts at its fileOffset in that file.
+size_t firstDirtyLine = 0;
+String savedPath = "";
+uint32_t savedFileSize = 0;
+
+void markDirty(size_t docIndex) {
+  if (docIndex < firstDirtyLine)
+    firstDirtyLine = docIndex;
+}
+
 // ------------------ Rendering ------------------
 
 // Count number of display lines
 int getTotalDisplayLines() {
   int total = 0;
   for (const auto& doc : docLines) {
-    total += doc.lines.size();
+    total += doc.displayLineCount();
   }
   return total;
 }
 
+void refreshAllLineIndexes();
+
+// Lay out every DocLine overlapping display lines [firstLine, firstLine + count).
+// Laying out can change a DocLine's line count, which shifts the lines after
+// it, so repeat until the range is stable.
+void layoutDisplayLines(ulong firstLine, ulong count) {
+  ulong lastLine = firstLine + count;
+  bool changed = true;
+
+  while (changed) {
+    changed = false;
+    for (auto& doc : docLines) {
+      if (doc.firstLineIndex >= lastLine)
+        break;
+      if (doc.laidOut || doc.firstLineIndex + doc.estLines <= firstLine)
+        continue;
+
+      doc.layout();
+      changed = true;
+    }
+
+    if (changed)
+      refreshAllLineIndexes();
+  }
+}
+
+// Lay out a single DocLine (the one being edited)
+void layoutDocLine(size_t docIndex) {
+  if (docIndex >= docLines.size() || docLines[docIndex].laidOut)
+    return;
+
+  docLines[docIndex].layout();
+  refreshAllLineIndexes();
+}
+
 // Display the entire document
 int displayDocument(int startX = 0, int startY = 0) {
   int cursorY = startY;
@@ -822,26 +1045,31 @@ void setFontOLED(bool bold, bool italic) {
   return;
 }
 
+// Returns the DocLine that owns a display line, or -1 if none does.
+// docLines are numbered in order, so this is a binary search on firstLineIndex.
+int getDocLineFromScrollLine(ulong scrollLineIndex) {
+  auto it = std::upper_bound(docLines.begin(), docLines.end(), scrollLineIndex,
+                             [](ulong index, const DocLine& dl) { return index < dl.firstLineIndex; });
+  if (it == docLines.begin())
+    return -1;
+  --it;
+  if (scrollLineIndex >= it->firstLineIndex + it->displayLineCount())
+    return -1;
+  return it - docLines.begin();
+}
+
 LineObject* getLineObjectByIndex(ulong targetIndex) {
-  for (auto& doc : docLines) {
-    for (auto& line : doc.lines) {
-      if (line.index == targetIndex) {
-        return &line;
-      }
-    }
-  }
-  return nullptr;  // not found
+  int docIndex = getDocLineFromScrollLine(targetIndex);
+  if (docIndex < 0 || !docLines[docIndex].laidOut)
+    return nullptr;  // not found
+  return &docLines[docIndex].lines[targetIndex - docLines[docIndex].firstLineIndex];
 }
 
 char getStyleFromScrollLine(ulong scrollLineIndex) {
-  for (auto& doc : docLines) {
-    for (auto& line : doc.lines) {
-      if (line.index == scrollLineIndex) {
-        return doc.style;  // <-- Return the DocLine style
-      }
-    }
-  }
-  return 'T';  // fallback if not found
+  int docIndex = getDocLineFromScrollLine(scrollLineIndex);
+  if (docIndex < 0 || !docLines[docIndex].laidOut)
+    return 'T';  // fallback if not found
+  return docLines[docIndex].style;
 }
 
 // Returns the pixel width of a LineObject on the OLED (vector of wordObjects)
@@ -866,6 +1094,8 @@ int getLineWidthOLED(const LineObject& lineObj) {
 void scrollPreview() {
   u8g2.clearBuffer();
 
+  layoutDisplayLines(lineScroll, LAYOUT_PREVIEW_LINES);
+
   uint16_t xInit = u8g2.getDisplayWidth() / 3;
 
   LineObject* scrollLinePtr = getLineObjectByIndex(lineScroll);
@@ -956,7 +1186,7 @@ void scrollPreview() {
   } else {
     return;
   }
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 void oledEditorDisplay(LineObject& lineObj, wordObject& currentWord, int pixelsUsed,
@@ -1064,18 +1294,22 @@ void oledEditorDisplay(LineObject& lineObj, wordObject& currentWord, int pixelsU
     OLED().infoBar();
   }
 
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // ------------------ Document ------------------
 
-// Parse and split all DocLines into rendered lines
+// Reset layout for all DocLines. Only line estimates are computed here, the
+// words and lines are built on demand by layoutDisplayLines().
 void populateLines(std::vector<DocLine>& docLines) {
   indexCounter = 0;
 
   for (auto& doc : docLines) {
-    doc.parseWords();
-    doc.splitToLines();
+    doc.words.clear();
+    doc.lines.clear();
+    doc.wordsEdited = false;
+    doc.laidOut = (doc.text.length() == 0);  // nothing to parse
+    doc.estimateLines();
   }
 }
 
@@ -1099,6 +1333,11 @@ void refreshAllLineIndexes() {
   // Refresh line indexes
   indexCounter = 0;                     // reset counter if you want indexes to start from 0
   for (auto& docLine : docLines) {      // iterate through all DocLines
+    docLine.firstLineIndex = indexCounter;
+    if (!docLine.laidOut) {
+      indexCounter += docLine.estLines;  // reserve estimated lines
+      continue;
+    }
     for (auto& line : docLine.lines) {  // iterate through each LineObject
       line.index = indexCounter++;
     }
@@ -1108,6 +1347,69 @@ void refreshAllLineIndexes() {
   refreshOrderedListIndexes();
 }
 
+// Classify one raw markdown line and append it to docLines
+void appendMarkdownLine(const char* line, size_t len, uint32_t fileOffset) {
+  // Trim whitespace (and the '\r' of CRLF files) from both ends
+  while (len > 0 && isspace((unsigned char)line[0])) {
+    line++;
+    len--;
+  }
+  while (len > 0 && isspace((unsigned char)line[len - 1]))
+    len--;
+
+  auto startsWith = [&](const char* prefix) {
+    size_t plen = strlen(prefix);
+    return len >= plen && memcmp(line, prefix, plen) == 0;
+  };
+  auto endsWith = [&](const char* suffix) {
+    size_t slen = strlen(suffix);
+    return len >= slen && memcmp(line + len - slen, suffix, slen) == 0;
+  };
+
+  char style = 'T';
+  size_t start = 0;  // content is line[start, end)
+  size_t end = len;
+
+  if (len == 0) {
+    style = 'B'; // Blank line
+  } else if (startsWith("### ")) {
+    style = '3'; // Heading 3
+    start = 4;
+  } else if (startsWith("## ")) {
+    style = '2'; // Heading 2
+    start = 3;
+  } else if (startsWith("# ")) {
+    style = '1'; // Heading 1
+    start = 2;
+  } else if (startsWith("> ")) {
+    style = '>'; // Quote Block
+    start = 2;
+  } else if (startsWith("- ")) {
+    style = '-'; // Unordered List
+    start = 2;
+  } else if (len == 3 && startsWith("---")) {
+    style = 'H'; // Horizontal Rule
+  } else if (startsWith("```")) {
+    style = 'C'; // Code Block
+    start = 3;
+    if (len >= 6 && endsWith("```"))
+      end = len - 3;
+  } else if (len >= 2 && startsWith("`") && endsWith("`")) {
+    style = 'C'; // Code Block
+    start = 1;
+    end = len - 1;
+  } else if (len > 2 && isDigit(line[0]) && line[1] == '.' && line[2] == ' ') {
+    style = 'L'; // Ordered List
+    start = 3;   // remove "1. ", "2. ", etc.
+  }
+
+  DocLine dl{};
+  dl.style = style;
+  dl.text.assign(line + start, end - start);
+  dl.fileOffset = fileOffset;  // start of the raw line, before trimming
+  docLines.push_back(std::move(dl));
+}
+
 // Load File
 void loadMarkdownFile(const String& path) {
   // Invalid file
@@ -1115,8 +1417,13 @@ void loadMarkdownFile(const String& path) {
     OLED().oledWord("No file saved! Creating blank file.");
     delay(2000);
 
+    // Nothing from the previous file carries over
+    docLines.clear();
+    savedPath = "";
+    firstDirtyLine = 0;
+
     // Create an empty new docLines object
-    docLines.push_back({'T', "", {}});
+    docLines.emplace_back();  // one blank text line
     editingLine_index = 0;
 
     // Populate and update as usual so UI doesn’t crash
@@ -1140,6 +1447,14 @@ void loadMarkdownFile(const String& path) {
   delay(50);
 
   docLines.clear();
+  savedPath = "";
+  firstDirtyLine = 0;
+
+  // A save interrupted between remove and rename leaves only the temp file
+  String tmpPath = path + ".tmp";
+  if (!SD_MMC.exists(path.c_str()) && SD_MMC.exists(tmpPath.c_str()))
+    SD_MMC.rename(tmpPath.c_str(), path.c_str());
+
   File file = SD_MMC.open(path.c_str(), FILE_READ);
   if (!file) {
     ESP_LOGE("SD", "File does not exist: %s", path.c_str());  // FIXME: - Come up with better error handling
@@ -1148,7 +1463,7 @@ void loadMarkdownFile(const String& path) {
     delay(2000);
 
     // Create an empty new docLines object
-    docLines.push_back({'T', "", {}});
+    docLines.emplace_back();  // one blank text line
     editingLine_index = 0;
 
     // Populate and update as usual so UI doesn’t crash
@@ -1161,60 +1476,52 @@ void loadMarkdownFile(const String& path) {
     return;
   }
 
+  // Read in large blocks and cut lines out of the buffer. Lines are only
+  // classified here, parsing and wrapping is left to layoutDisplayLines().
+  std::vector<char> chunk(LOAD_CHUNK_SIZE);
+  std::vector<char> pending;
+  uint32_t fileOffset = 0;
+  uint32_t lineStart = 0;
+
   while (file.available()) {
-    String line = file.readStringUntil('\n');
-    line.trim();
-    char style = 'T';
-    String content = line;  // default is full line
-
-    if (line.length() == 0) {
-      style = 'B'; // Blank line
-      content = "";
-    } else if (line.startsWith("### ")) {
-      style = '3'; // Heading 3
-      content = line.substring(4);  // remove "### "
-    } else if (line.startsWith("## ")) {
-      style = '2'; // Heading 2
-      content = line.substring(3);  // remove "## "
-    } else if (line.startsWith("# ")) {
-      style = '1'; // Heading 1
-      content = line.substring(2);  // remove "# "
-    } else if (line.startsWith("> ")) {
-      style = '>'; // Quote Block
-      content = line.substring(2);  // remove "> "
-    } else if (line.startsWith("- ")) {
-      style = '-'; // Unordered List
-      content = line.substring(2); // remove "- "
-    } else if (line == "---") {
-      style = 'H'; // Horizontal Rule
-      content = "---";  // horizontal line has no content
-    } else if ((line.startsWith("```")) || (line.startsWith("`") && line.endsWith("`")) || (line.startsWith("```") && line.endsWith("```"))) {
-      if (line.startsWith("```"))
-        content = line.substring(3);
-      else if (line.startsWith("```") && line.endsWith("```"))
-        content = line.substring(3, line.length() - 3);
-      else if (line.startsWith("`") && line.endsWith("`"))
-        content = line.substring(1, line.length() - 1);
-
-      style = 'C'; // Code Block
-    } else if (line.length() > 2 && isDigit(line.charAt(0)) && line.charAt(1) == '.' &&
-               line.charAt(2) == ' ') {
-      style = 'L'; // Ordered List
-      content = line.substring(3); // remove "1. ", "2. ", etc.
-    }
-
-    docLines.push_back({style, content, {}});
+    size_t n = file.read((uint8_t*)chunk.data(), chunk.size());
+    if (n == 0)
+      break;
+
+    size_t segStart = 0;
+    for (size_t i = 0; i < n; i++) {
+      if (chunk[i] != '\n')
+        continue;
+
+      pending.insert(pending.end(), chunk.begin() + segStart, chunk.begin() + i);
+      appendMarkdownLine(pending.data(), pending.size(), lineStart);
+      pending.clear();
+
+      segStart = i + 1;
+      lineStart = fileOffset + segStart;
+    }
+    pending.insert(pending.end(), chunk.begin() + segStart, chunk.begin() + n);
+    fileOffset += n;
   }
 
+  // Last line without a trailing newline
+  if (!pending.empty())
+    appendMarkdownLine(pending.data(), pending.size(), lineStart);
+
   file.close();
 
   if (docLines.empty()) {
-    docLines.push_back({'T', "", {}});
+    docLines.emplace_back();  // one blank text line
     editingLine_index = 0;
   } else {
-    editingLine_index = docLines.size() - 1;
+    editingLine_index = lastDocLineIndex();
   }
 
+  // Everything matches the file on disk
+  savedPath = path;
+  savedFileSize = fileOffset;
+  firstDirtyLine = docLines.size();
+
   // Populate all the lines
   populateLines(docLines);
 
@@ -1230,6 +1537,104 @@ void loadMarkdownFile(const String& path) {
   fileLoaded = true;
 }
 
+// Buffered writer so a save is a few block-sized SD writes, not one per line
+struct SaveWriter {
+  File& file;
+  std::vector<char> buf;
+  uint32_t offset;  // file position of the next byte
+  bool ok = true;
+
+  SaveWriter(File& f, uint32_t startOffset) : file(f), offset(startOffset) {
+    buf.reserve(LOAD_CHUNK_SIZE);
+  }
+
+  void put(const char* s, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+      buf.push_back(s[i]);
+      if (buf.size() >= LOAD_CHUNK_SIZE)
+        flush();
+    }
+    offset += n;
+  }
+
+  void put(const String& s) { put(s.c_str(), s.length()); }
+
+  void flush() {
+    if (buf.empty())
+      return;
+    if (file.write((const uint8_t*)buf.data(), buf.size()) != buf.size())
+      ok = false;
+    buf.clear();
+  }
+};
+
+// Markdown written before and after a DocLine's text
+void markdownAffixes(char style, const char*& prefix, const char*& suffix) {
+  suffix = "";
+  switch (style) {
+    case '1': prefix = "# "; break;
+    case '2': prefix = "## "; break;
+    case '3': prefix = "### "; break;
+    case '>': prefix = "> "; break;
+    case '-': prefix = "- "; break;
+    case 'L': prefix = "1. "; break;
+    case 'C': prefix = "```"; suffix = "```"; break;
+    default:  prefix = ""; break;
+  }
+}
+
+// Bytes a DocLine takes on disk, including the line ending
+uint32_t serializedLength(const DocLine& dl) {
+  if (dl.style == 'H')
+    return 3 + 2;
+  if (dl.style == 'B')
+    return 2;
+
+  const char* prefix;
+  const char* suffix;
+  markdownAffixes(dl.style, prefix, suffix);
+  return strlen(prefix) + dl.text.length() + strlen(suffix) + 2;
+}
+
+// Printable characters in a DocLine as saved (for metadata)
+int visibleChars(const DocLine& dl) {
+  if (dl.style == 'H')
+    return 3;
+  if (dl.style == 'B')
+    return 0;
+
+  const char* prefix;
+  const char* suffix;
+  markdownAffixes(dl.style, prefix, suffix);
+  int count = strlen(prefix) + strlen(suffix);
+  for (size_t i = 0; i < dl.text.length(); i++) {
+    char c = dl.text.charAt(i);
+    if (c >= 32 && c <= 126)
+      count++;
+  }
+  return count;
+}
+
+void writeDocLine(SaveWriter& out, DocLine& dl) {
+  dl.fileOffset = out.offset;
+
+  if (dl.style == 'H') {
+    out.put("---", 3);
+  } else if (dl.style != 'B') {
+    const char* prefix;
+    const char* suffix;
+    markdownAffixes(dl.style, prefix, suffix);
+    out.put(prefix, strlen(prefix));
+    out.put(dl.text.toString());
+    out.put(suffix, strlen(suffix));
+  }
+  out.put("\r\n", 2);
+}
+
+// Save File
+// Only DocLines from firstDirtyLine on have changed since the last save. If
+// the file on disk would only grow, those are rewritten in place; otherwise
+// the whole document goes to a temp file that replaces the original.
 void saveMarkdownFile(const String& path) {
   if (SD().getNoSD()) {
     OLED().oledWord("SAVE FAILED - No SD!");
@@ -1237,10 +1642,6 @@ void saveMarkdownFile(const String& path) {
     return;
   }
 
-  SDActive = true;
-  setCpuFrequencyMhz(240);
-  delay(50);
-
   // Determine save path
   String savePath = path;
   if (savePath == "" || savePath == "-")
@@ -1248,45 +1649,105 @@ void saveMarkdownFile(const String& path) {
   if (!savePath.startsWith("/"))
     savePath = "/" + savePath;
 
-  File file = SD_MMC.open(savePath.c_str(), FILE_WRITE);
-  if (!file) {
-    OLED().oledWord("SAVE FAILED - OPEN ERR");
-    delay(2000);
-    ESP_LOGE("SD", "Failed to open file for writing: %s", savePath.c_str());
-    SDActive = false;
+  // Offsets only describe the file they were loaded from or saved to
+  if (savePath != savedPath)
+    firstDirtyLine = 0;
+
+  // Nothing changed since the last save
+  if (firstDirtyLine >= docLines.size() && savePath == savedPath) {
+    OLED().oledWord("Saved: " + savePath);
     return;
   }
 
-  // Write each DocLine as Markdown
-  for (auto &dl : docLines) {
-    dl.compileToText();
+  SDActive = true;
+  setCpuFrequencyMhz(240);
 
-    String out;
+  // Bring append-mode edits into the text and size the new file. The clean
+  // head stays as it is on disk, so the tail starts at its first line's offset.
+  uint32_t fullBytes = 0;
+  uint32_t tailBytes = 0;
+  int charCount = 0;
+  for (size_t i = 0; i < docLines.size(); i++) {
+    if (i >= firstDirtyLine) {
+      docLines[i].syncText();
+      tailBytes += serializedLength(docLines[i]);
+    }
+    fullBytes += serializedLength(docLines[i]);
+    charCount += visibleChars(docLines[i]);
+  }
+
+  uint32_t headBytes = (firstDirtyLine < docLines.size()) ? docLines[firstDirtyLine].fileOffset : 0;
+  uint32_t newFileSize = fullBytes;
+
+  // Overwriting in place cannot shrink the file, anything shorter needs a full save
+  bool tailOnly = (firstDirtyLine > 0 && firstDirtyLine < docLines.size() &&
+                   headBytes + tailBytes >= savedFileSize);
+  bool ok = false;
+
+  if (tailOnly) {
+    File file = SD_MMC.open(savePath.c_str(), "r+");
+    if (file) {
+      file.seek(headBytes);
+      SaveWriter out(file, headBytes);
+      for (size_t i = firstDirtyLine; i < docLines.size(); i++)
+        writeDocLine(out, docLines[i]);
+      out.flush();
+      file.close();
+      ok = out.ok;
+      newFileSize = headBytes + tailBytes;
+    }
+    if (!ok)
+      ESP_LOGW("SD", "Tail rewrite failed, saving full file: %s", savePath.c_str());
+  }
 
-    switch (dl.style) {
-      case '1': out = "# " + dl.line; break;
-      case '2': out = "## " + dl.line; break;
-      case '3': out = "### " + dl.line; break;
-      case '>': out = "> " + dl.line; break;
-      case '-': out = "- " + dl.line; break;
-      case 'L': out = "1. " + dl.line; break; //String(dl.orderedListNumber) + ". " + dl.line; break;
-      case 'H': out = "---"; break;
-      case 'C': out = "```" + dl.line + "```"; break;
-      case 'B': out = ""; break;
-      default:  out = dl.line; break;
+  if (!ok) {
+    tailOnly = false;
+    newFileSize = fullBytes;
+    String tmpPath = savePath + ".tmp";
+
+    File file = SD_MMC.open(tmpPath.c_str(), FILE_WRITE);
+    if (!file) {
+      OLED().oledWord("SAVE FAILED - OPEN ERR");
+      delay(2000);
+      ESP_LOGE("SD", "Failed to open file for writing: %s", tmpPath.c_str());
+      SDActive = false;
+      return;
     }
 
-    file.println(out);
+    SaveWriter out(file, 0);
+    for (auto& dl : docLines)
+      writeDocLine(out, dl);
+    out.flush();
+    file.close();
+
+    // FAT cannot rename over an existing file, so remove the old one first
+    if (out.ok) {
+      if (SD_MMC.exists(savePath.c_str()))
+        SD_MMC.remove(savePath.c_str());
+      ok = SD_MMC.rename(tmpPath.c_str(), savePath.c_str());
+    }
+
+    if (!ok) {
+      OLED().oledWord("SAVE FAILED - WRITE ERR");
+      delay(2000);
+      ESP_LOGE("SD", "Failed to write %s", savePath.c_str());
+      SDActive = false;
+      return;
+    }
   }
 
-  file.close();
+  ESP_LOGI("SD", "Saved %s: %s, %u bytes written", savePath.c_str(),
+           tailOnly ? "tail" : "full", (unsigned)(newFileSize - (tailOnly ? headBytes : 0)));
+
+  savedPath = savePath;
+  savedFileSize = newFileSize;
+  firstDirtyLine = docLines.size();
 
   // Save metadata
-  pocketmage::file::writeMetadata(savePath);
+  pocketmage::file::writeMetadata(savePath, newFileSize, charCount);
   SD().setEditingFile(savePath);
 
   OLED().oledWord("Saved: " + savePath);
-  delay(1000);
 
   if (SAVE_POWER)
     setCpuFrequencyMhz(POWER_SAVE_FREQ);
@@ -1316,6 +1777,398 @@ int getLineWidth(const LineObject& lineObj, char style) {
   return lineWidth;
 }
 
+// ------------------ Inline Editing ------------------
+// Inline mode edits the raw markdown of a single DocLine through its gap
+// buffer. Only the DocLines touched by an edit are re-parsed and re-wrapped.
+
+// Renumber display lines from DocLine first onward. DocLines after last keep
+// their relative numbering, so once one is found already at the right index
+// the rest of the document is left alone.
+void refreshLineIndexesFrom(size_t first, size_t last) {
+  ulong counter = 0;
+  if (first > 0) {
+    const DocLine& prev = docLines[first - 1];
+    counter = prev.firstLineIndex + prev.displayLineCount();
+  }
+
+  for (size_t i = first; i < docLines.size(); i++) {
+    DocLine& docLine = docLines[i];
+    if (i > last && docLine.firstLineIndex == counter)
+      break;
+    docLine.firstLineIndex = counter;
+    if (!docLine.laidOut) {
+      counter += docLine.estLines;
+      continue;
+    }
+    for (auto& line : docLine.lines) {
+      line.index = counter++;
+    }
+  }
+
+  // Next free display index, as refreshAllLineIndexes() leaves it
+  const DocLine& tail = docLines.back();
+  indexCounter = tail.firstLineIndex + tail.displayLineCount();
+
+  // List numbering, continuing the run that ends before first
+  bool prevWasList = first > 0 && docLines[first - 1].style == 'L';
+  ulong currentNumber = prevWasList ? docLines[first - 1].orderedListNumber : 0;
+  for (size_t i = first; i < docLines.size(); i++) {
+    DocLine& dl = docLines[i];
+    const bool isList = dl.style == 'L';
+    const ulong number = isList ? (prevWasList ? currentNumber + 1 : 1) : (ulong)-1;
+    if (i > last && dl.orderedListNumber == number)
+      break;
+    dl.orderedListNumber = number;
+    currentNumber = number;
+    prevWasList = isList;
+  }
+}
+
+// Re-parse and re-wrap DocLines [first, last], then renumber display lines
+void relayoutDocLines(size_t first, size_t last) {
+  if (docLines.empty())
+    return;
+  if (last >= docLines.size())
+    last = docLines.size() - 1;
+
+  for (size_t i = first; i <= last; i++) {
+    docLines[i].layout();
+  }
+
+  refreshLineIndexesFrom(first, last);
+}
+
+// Scroll the e-ink view to the DocLine being edited
+void scrollToEditingLine() {
+  DocLine& dl = docLines[editingLine_index];
+  if (!dl.lines.empty()) {
+    lineScroll = dl.lines.front().index;
+    return;
+  }
+  // Lines without text (blank, empty) have no LineObjects, use the previous one
+  for (int i = (int)editingLine_index - 1; i >= 0; i--) {
+    if (!docLines[i].lines.empty()) {
+      lineScroll = docLines[i].lines.back().index;
+      return;
+    }
+  }
+  lineScroll = 0;
+}
+
+// Save to the current file, or switch to SAVE_AS if there is none.
+// Returns false if the user was prompted for a filename.
+bool saveOrPromptPath() {
+  String savePath = SD().getEditingFile();
+  if (savePath == "" || savePath == "-" || savePath == "/temp.txt") {
+    KB().setKeyboardState(NORMAL);
+    CurrentTXTState_NEW = SAVE_AS;
+    return false;
+  }
+
+  saveMarkdownFile(savePath);
+  return true;
+}
+
+void enterInlineEdit(ulong scrollLineIndex) {
+  int docIndex = getDocLineFromScrollLine(scrollLineIndex);
+  if (docIndex < 0)
+    return;
+
+  editingLine_index = docIndex;
+  layoutDocLine(editingLine_index);
+  DocLine& dl = docLines[editingLine_index];
+
+  // Append mode edits words directly, bring the raw text up to date first
+  dl.syncText();
+  dl.text.moveCursor(dl.text.length());
+
+  currentEditMode = edit_inline;
+  KB().setKeyboardState(NORMAL);
+}
+
+void exitInlineEdit() {
+  currentEditMode = edit_append;
+
+  // Append mode always continues at the end of the document
+  editingLine_index = lastDocLineIndex();
+  if (!docLines.empty())
+    scrollToEditingLine();
+  updateScreen = true;
+}
+
+void oledInlineDisplay(const DocLine& dl, bool currentlyTyping) {
+  u8g2.clearBuffer();
+  setFontOLED(false, false);
+
+  const int maxWidth = u8g2.getDisplayWidth() - 8;
+  const size_t cursor = dl.text.cursor();
+  const size_t len = dl.text.length();
+  char glyph[2] = {0, 0};
+
+  // Walk back from the cursor until the window is full
+  size_t start = cursor;
+  int cursorX = 0;
+  while (start > 0) {
+    glyph[0] = dl.text.charAt(start - 1);
+    int w = u8g2.getStrWidth(glyph);
+    if (cursorX + w > maxWidth)
+      break;
+    cursorX += w;
+    start--;
+  }
+
+  // Draw from the window start, stopping at the right edge
+  int xpos = 0;
+  for (size_t i = start; i < len; i++) {
+    glyph[0] = dl.text.charAt(i);
+    int w = u8g2.getStrWidth(glyph);
+    if (xpos + w > u8g2.getDisplayWidth())
+      break;
+    u8g2.drawStr(xpos, 20, glyph);
+    xpos += w;
+  }
+
+  // Cursor
+  u8g2.drawVLine(cursorX + 1, 1, 22);
+
+  if (currentlyTyping) {
+    wordObject plain = {"", false, false};
+    toolBar(plain);
+  } else {
+    OLED().infoBar();
+  }
+
+  OLED().sendBuffer();
+}
+
+void editInline(char inchar) {
+  static ulong lastTypeMillis = 0;
+  ulong currentMillis = millis();
+
+  if (docLines.empty()) {
+    exitInlineEdit();
+    return;
+  }
+  if (editingLine_index >= docLines.size())
+    editingLine_index = lastDocLineIndex();
+
+  DocLine* dl = &docLines[editingLine_index];
+  size_t displayLinesBefore = dl->displayLineCount();
+  bool textChanged = false;
+  bool moveView = false;
+
+  if (inchar != 0) {
+    setCpuFrequencyMhz(240);
+  }
+
+  // HANDLE INPUTS
+  // No char recieved
+  if (inchar == 0) {
+  }
+  // Return home
+  else if (inchar == 12) {
+    HOME_INIT();
+    return;
+  }
+  // TAB or ESC Recieved, back to append mode
+  else if (inchar == 9 || inchar == 20) {
+    exitInlineEdit();
+    return;
+  }
+  // SHIFT Recieved
+  else if (inchar == 17) {
+    if (KB().getKeyboardState() == SHIFT)
+      KB().setKeyboardState(NORMAL);
+    else
+      KB().setKeyboardState(SHIFT);
+  }
+  // FN Recieved
+  else if (inchar == 18) {
+    if (KB().getKeyboardState() == FUNC)
+      KB().setKeyboardState(NORMAL);
+    else
+      KB().setKeyboardState(FUNC);
+  }
+  // LEFT
+  else if (inchar == 19) {
+    if (dl->text.cursor() > 0) {
+      dl->text.moveCursor(dl->text.cursor() - 1);
+    } else if (editingLine_index > 0) {
+      // Continue at the end of the previous DocLine
+      editingLine_index--;
+      dl = &docLines[editingLine_index];
+      dl->syncText();
+      dl->text.moveCursor(dl->text.length());
+      moveView = true;
+    }
+  }
+  // RIGHT
+  else if (inchar == 21) {
+    if (dl->text.cursor() < dl->text.length()) {
+      dl->text.moveCursor(dl->text.cursor() + 1);
+    } else if (editingLine_index + 1 < docLines.size()) {
+      // Continue at the start of the next DocLine
+      editingLine_index++;
+      dl = &docLines[editingLine_index];
+      dl->syncText();
+      dl->text.moveCursor(0);
+      moveView = true;
+    }
+  }
+  // SHFT + LEFT (Text type select)
+  else if (inchar == 28) {
+    static const char styleCycle[] = {'T', '1', '2', '3', '>', 'L', '-', 'C', 'H'};
+    static const int numStyles = sizeof(styleCycle) / sizeof(styleCycle[0]);
+
+    int currentIndex = 0;
+    for (int i = 0; i < numStyles; i++) {
+      if (dl->style == styleCycle[i]) {
+        currentIndex = i;
+        break;
+      }
+    }
+    dl->style = styleCycle[(currentIndex + 1) % numStyles];
+    if (dl->style == 'H')
+      dl->text = "---";
+
+    relayoutDocLines(editingLine_index, editingLine_index);
+    markDirty(editingLine_index);
+    updateScreen = true;
+  }
+  // ENTER Received, split the DocLine at the cursor
+  else if (inchar == 13) {
+    char nextLineStyle = dl->style;
+    if (nextLineStyle != 'C' && nextLineStyle != '>' && nextLineStyle != '-' &&
+        nextLineStyle != 'L') {
+      nextLineStyle = 'T';
+    }
+
+    DocLine newDocLine;
+    newDocLine.style = nextLineStyle;
+    newDocLine.text = dl->text.cutTail();
+    newDocLine.text.moveCursor(0);
+
+    if (dl->text.length() == 0 && dl->style != 'H')
+      dl->style = 'B';
+
+    markDirty(editingLine_index);
+    docLines.insert(docLines.begin() + editingLine_index + 1, std::move(newDocLine));
+    relayoutDocLines(editingLine_index, editingLine_index + 1);
+
+    editingLine_index++;
+    dl = &docLines[editingLine_index];
+    updateScreen = true;
+    moveView = true;
+  }
+  // BKSP Received
+  else if (inchar == 8) {
+    if (dl->text.eraseBefore()) {
+      textChanged = true;
+    } else if (editingLine_index > 0) {
+      DocLine& prev = docLines[editingLine_index - 1];
+      markDirty(editingLine_index - 1);
+
+      if (prev.style == 'B' || prev.style == 'H') {
+        // Nothing to join with, just drop the blank line or rule. This line
+        // now starts where the removed one did, so a save rewrites from there.
+        dl->fileOffset = prev.fileOffset;
+        docLines.erase(docLines.begin() + editingLine_index - 1);
+        editingLine_index--;
+        dl = &docLines[editingLine_index];
+        refreshAllLineIndexes();
+      } else {
+        // Join this DocLine onto the end of the previous one
+        prev.syncText();
+        size_t joinAt = prev.text.length();
+        String tail = dl->text.toString();
+
+        prev.text.moveCursor(joinAt);
+        prev.text.insert(tail.c_str(), tail.length());
+        prev.text.moveCursor(joinAt);
+
+        docLines.erase(docLines.begin() + editingLine_index);
+        editingLine_index--;
+        dl = &docLines[editingLine_index];
+        relayoutDocLines(editingLine_index, editingLine_index);
+      }
+      updateScreen = true;
+      moveView = true;
+    }
+  }
+  // SAVE Recieved
+  else if (inchar == 6) {
+    if (!saveOrPromptPath())
+      return;
+  }
+  // FILE Recieved
+  else if (inchar == 7) {
+    currentEditMode = edit_append;
+    CurrentTXTState_NEW = LOAD_FILE;
+    KB().setKeyboardState(NORMAL);
+    return;
+  }
+  // Font Switcher
+  else if (inchar == 14) {
+    CurrentTXTState_NEW = FONT;
+    KB().setKeyboardState(FUNC);
+    updateScreen = true;
+  } else {
+    // Typing into a blank line or rule turns it into body text
+    if (dl->style == 'H') {
+      dl->text = "";
+      dl->style = 'T';
+    } else if (dl->style == 'B') {
+      dl->style = 'T';
+    }
+
+    dl->text.insert(inchar);
+    textChanged = true;
+
+    if (inchar >= 48 && inchar <= 57) {
+    }  // Only leave FN on if typing numbers
+    else if (KB().getKeyboardState() != NORMAL) {
+      KB().setKeyboardState(NORMAL);
+    }
+  }
+
+  // Re-wrap only the edited DocLine, refresh e-ink if its height changed
+  if (textChanged) {
+    markDirty(editingLine_index);
+    relayoutDocLines(editingLine_index, editingLine_index);
+    if (dl->lines.size() != displayLinesBefore) {
+      updateScreen = true;
+      moveView = true;
+    }
+  }
+
+  if (inchar != 0) {
+    lastTypeMillis = millis();
+  }
+
+  currentMillis = millis();
+  // Make sure oled only updates at 60fps
+  if (currentMillis - OLEDFPSMillis >= (1000 / 60)) {
+    OLEDFPSMillis = currentMillis;
+    if (TOUCH().getLastTouch() == -1) {
+      bool currentlyTyping = (millis() - lastTypeMillis < TYPE_INTERFACE_TIMEOUT);
+
+      // Flush KB IC if not in use
+      if (!currentlyTyping)
+        KB().flush();
+
+      oledInlineDisplay(*dl, currentlyTyping);
+    } else {
+      scrollPreview();
+    }
+  }
+
+  if (moveView)
+    scrollToEditingLine();
+
+  if (SAVE_POWER)
+    setCpuFrequencyMhz(POWER_SAVE_FREQ);
+}
+
 void editAppend(char inchar) {
   static ulong lastTypeMillis = 0;
   ulong currentMillis = millis();
@@ -1325,6 +2178,7 @@ void editAppend(char inchar) {
   // Lower baseline clock speed here?
 
   // Direct access to DocLine, LineObject, and wordObject
+  layoutDocLine(editingLine_index);
   DocLine& editingDocLine = docLines[editingLine_index];
   LineObject* lastLine;
   wordObject* lastWord;
@@ -1360,6 +2214,8 @@ void editAppend(char inchar) {
   else if (inchar == 9) {
     // If scrolling, edit inline
     if (TOUCH().getLastTouch() != -1) {
+      enterInlineEdit(lineScroll);
+      return;
     }
 
   }
@@ -1379,6 +2235,8 @@ void editAppend(char inchar) {
   }
   // Space Recieved
   else if (inchar == 32) {
+    editingDocLine.wordsEdited = true;
+    markDirty(editingLine_index);
     if (getLineWidth(*lastLine, editingDocLine.style) > display.width() - DISPLAY_WIDTH_BUFFER) {
       // Word does not fit -> wrap to new line
       // Remove the word from the old line
@@ -1412,9 +2270,11 @@ void editAppend(char inchar) {
   }
   // ENTER Received
   else if (inchar == 13) {
+    editingDocLine.wordsEdited = true;
+    markDirty(editingLine_index);
     // Horizontal Rule
     if (editingDocLine.style == 'H') {
-      editingDocLine.line = "---";
+      editingDocLine.text = "---";
       editingDocLine.words.clear();
       editingDocLine.parseWords();
       editingDocLine.splitToLines();
@@ -1455,6 +2315,7 @@ void editAppend(char inchar) {
     // Finish current DocLine and create a new one
     DocLine newDocLine;
     newDocLine.style = nextLineStyle;
+    newDocLine.laidOut = true;
 
     // Add one line and one empty word
     LineObject newLine;
@@ -1504,9 +2365,12 @@ void editAppend(char inchar) {
     // Move to next style in cycle
     currentIndex = (currentIndex + 1) % numStyles;
     editingDocLine.style = styleCycle[currentIndex];
+    markDirty(editingLine_index);
   }
   // SHFT + RIGHT (Word type select)
   else if (inchar == 30) {
+    editingDocLine.wordsEdited = true;
+    markDirty(editingLine_index);
     if (lastWord->bold == false && lastWord->italic == false) {
       // If regular text switch to bold
       lastWord->bold = true;
@@ -1527,6 +2391,8 @@ void editAppend(char inchar) {
   }
   // BKSP Received
   else if (inchar == 8) {
+    editingDocLine.wordsEdited = true;
+    markDirty(editingLine_index);
     if (lastWord->text.length() > 0) {
       // Remove the last character of the current word
       lastWord->text.remove(lastWord->text.length() - 1);
@@ -1551,7 +2417,10 @@ void editAppend(char inchar) {
         } else if (editingLine_index > 0) {
           // Move to previous DocLine
           editingLine_index--;
+          layoutDocLine(editingLine_index);
           DocLine& prevDocLine = docLines[editingLine_index];
+          prevDocLine.wordsEdited = true;
+          markDirty(editingLine_index);
           linePtr = &prevDocLine.lines.back();
           wordPtr = &linePtr->words.back();
         } else {
@@ -1567,15 +2436,8 @@ void editAppend(char inchar) {
   }
   // SAVE Recieved
   else if (inchar == 6) {
-    String savePath = SD().getEditingFile();
-    if (savePath == "" || savePath == "-" || savePath == "/temp.txt") {
-      KB().setKeyboardState(NORMAL);
-      CurrentTXTState_NEW = SAVE_AS;
+    if (!saveOrPromptPath())
       return;
-    }
-    if (!savePath.startsWith("/")) savePath = "/" + savePath;
-    
-    saveMarkdownFile(SD().getEditingFile());
   }
   // FILE Recieved
   else if (inchar == 7) {
@@ -1590,6 +2452,8 @@ void editAppend(char inchar) {
   } else {
     // Add char to current word
     lastWord->text += inchar;
+    editingDocLine.wordsEdited = true;
+    markDirty(editingLine_index);
 
     if (inchar >= 48 && inchar <= 57) {
     }  // Only leave FN on if typing numbers
@@ -1613,7 +2477,7 @@ void editAppend(char inchar) {
 
       // Flush KB IC if not in use
       if (!currentlyTyping)
-        keypad.flush();
+        KB().flush();
 
       int lineWidth = getLineWidth(*lastLine, editingDocLine.style);
 
@@ -1626,11 +2490,12 @@ void editAppend(char inchar) {
 
   // Center scroll on typed line if a line update has been registered
   if (moveView) {
-    // Update scroll to currently edited line
-    if (editingDocLine.lines.empty())
+    // Update scroll to currently edited line (ENTER may have reallocated docLines)
+    DocLine& currentDocLine = docLines[editingLine_index];
+    if (currentDocLine.lines.empty())
       lineScroll = 0;
     else
-      lineScroll = editingDocLine.lines.back().index;
+      lineScroll = currentDocLine.lines.back().index;
   }
 
   if (SAVE_POWER)
@@ -1765,6 +2630,8 @@ void einkHandler_TXT_NEW() {
     updateScreen = false;
     display.setFullWindow();
     display.fillScreen(GxEPD_WHITE);
+    ulong firstVisible = (lineScroll > SCROLL_LINE_OFFSET) ? lineScroll - SCROLL_LINE_OFFSET : 0;
+    layoutDisplayLines(firstVisible, LAYOUT_VIEWPORT_LINES);
     displayDocument();
     EINK().refresh();
     refreshAllLineIndexes();
@@ -1796,7 +2663,7 @@ void processKB_TXT_NEW() {
             editAppend(inchar);
             break;
           case edit_inline:
-
+            editInline(inchar);
             break;
         }
       }
@@ -504,7 +504,7 @@ static void update_oled() {
     u8g2.drawStr(0, 8, "Periodic Table");
     u8g2.drawStr(0, 16, "Arrows: Navigate");
     u8g2.drawStr(0, 24, "Enter: Details");
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
 #endif
     return;
   }
@@ -537,7 +537,7 @@ static void update_oled() {
   u8g2.drawStr(0, 8, line1);
   u8g2.drawStr(0, 16, line2);
   u8g2.drawStr(0, 24, line3);
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 #endif
 }
 
@@ -641,7 +641,7 @@ void processKB_PERIODIC() {
       oled_set_lines("", "", "");  // Clear OLED display
 #else
       u8g2.clearBuffer();
-      u8g2.sendBuffer();
+      OLED().sendBuffer();
 #endif
       return;
     }
@@ -708,7 +708,7 @@ void processKB_PERIODIC() {
     oled_set_lines("", "", "");  // Clear OLED display
 #else
     u8g2.clearBuffer();
-    u8g2.sendBuffer();
+    OLED().sendBuffer();
 #endif
     // CRITICAL: Return immediately to prevent further rendering after app exit
     return;
@@ -482,7 +482,7 @@ void processKB_POKEDEX() {
         refresh();
         
         u8g2.clearBuffer();
-        u8g2.sendBuffer();
+        OLED().sendBuffer();
         
         CurrentAppState = HOME;
         newState = true;
@@ -611,7 +611,7 @@ void updatePokedexOLED() {
       break;
   }
   
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 // New drawing functions that use the graphics adapter
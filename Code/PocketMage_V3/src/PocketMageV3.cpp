@@ -168,13 +168,11 @@ void loop() {
   if (!noTimeout)  pocketmage::time::checkTimeout();
   if (DEBUG_VERBOSE) pocketmage::debug::printDebug();
 
-  PowerSystem.printDiagnostics(); // power diag
-  
   pocketmage::power::updateBattState();
   processKB();
 
-  // Yield to watchdog
-  vTaskDelay(50 / portTICK_PERIOD_MS);
+  // Sleep until input, a service event or the next tick
+  pocketmage::power::waitForLoopWork();
   yield();
 }
 
@@ -184,7 +182,7 @@ void einkHandler(void* parameter) {
   for (;;) {
     applicationEinkHandler();
 
-    vTaskDelay(pdMS_TO_TICKS(50));
+    pocketmage::power::waitForEinkWork();
     yield();
   }
 }
\ No newline at end of file
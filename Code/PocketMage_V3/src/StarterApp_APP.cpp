@@ -81,7 +81,7 @@ void processKB_STARTERAPP() {
   } else {
     u8g2.drawStr(0, 12, "Circle Demo");
   }
-  u8g2.sendBuffer();
+  OLED().sendBuffer();
 }
 
 void einkHandler_STARTERAPP() {
@@ -91,12 +91,12 @@ void processKB_TXT() {
         else if (inchar == 6) {
           //File exists, save normally
           if (editingFile != "" && editingFile != "-") {
-            keypad.disableInterrupts();
+            KB().disableInterrupts();
             oledWord("Saving File");
             writeFile(SPIFFS, editingFile.c_str(), allText.c_str());
             oledWord("Saved");
             delay(200);
-            keypad.enableInterrupts();
+            KB().enableInterrupts();
             CurrentKBState = NORMAL;
             newState = true;
           }
@@ -111,10 +111,10 @@ void processKB_TXT() {
         }
         //LOAD Recieved
         else if (inchar == 5) {
-          keypad.disableInterrupts();
+          KB().disableInterrupts();
           oledWord("Loading File");
           allText = readFileToString(SPIFFS, ("/" + editingFile).c_str());
-          keypad.enableInterrupts();
+          KB().enableInterrupts();
           CurrentKBState = NORMAL;
           newState = true;
         }
@@ -218,7 +218,7 @@ void processKB_TXT() {
             //File to be saved exists
             else {
               //Save current file
-              keypad.disableInterrupts();
+              KB().disableInterrupts();
               oledWord("Saving File");
               writeFile(SPIFFS, prevEditingFile.c_str(), allText.c_str());
               oledWord("Saved");
@@ -226,7 +226,7 @@ void processKB_TXT() {
               //Load new file
               oledWord("Loading File");
               allText = readFileToString(SPIFFS, editingFile.c_str());
-              keypad.enableInterrupts();
+              KB().enableInterrupts();
               //Return to TXT
               CurrentTXTState = TXT_;
               CurrentKBState = NORMAL;
@@ -239,10 +239,10 @@ void processKB_TXT() {
           else if (numSelect == 2) {
             Serial.println("NO  (don't save current file)");
             //Just load new file
-            keypad.disableInterrupts();
+            KB().disableInterrupts();
             oledWord("Loading File");
             allText = readFileToString(SPIFFS, ("/" + editingFile).c_str());
-            keypad.enableInterrupts();
+            KB().enableInterrupts();
             //Return to TXT
             CurrentTXTState = TXT_;
             CurrentKBState = NORMAL;
@@ -292,14 +292,14 @@ void processKB_TXT() {
           prevEditingFile = "/" + currentWord + ".txt";
 
           //Save the file
-          keypad.disableInterrupts();
+          KB().disableInterrupts();
           oledWord("Saving File");
           writeFile(SPIFFS, prevEditingFile.c_str(), allText.c_str());
           oledWord("Saved");
           delay(200);
           //Load new file
 
-          keypad.enableInterrupts();
+          KB().enableInterrupts();
 
           //Return to TXT_
           CurrentTXTState = TXT_;
@@ -357,12 +357,12 @@ void processKB_TXT() {
           editingFile = "/" + currentWord + ".txt";
 
           //Save the file
-          keypad.disableInterrupts();
+          KB().disableInterrupts();
           oledWord("Saving " + editingFile);
           writeFile(SPIFFS, editingFile.c_str(), allText.c_str());
           oledWord("Saved " + editingFile);
           delay(200);
-          keypad.enableInterrupts();
+          KB().enableInterrupts();
           //Ask to save prev file
           
           //Return to TXT_
@@ -423,9 +423,9 @@ void einkHandler_TXT() {
         display.fillRect(60,0,200,218,GxEPD_WHITE);
         display.drawBitmap(60,0,fileWizLiteallArray[0],200,218, GxEPD_BLACK);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < MAX_FILES; i++) {
           display.setCursor(88, 54+(17*i));
@@ -819,7 +819,7 @@ void processKB_TXT_NEW() {
           //Load new file
           loadFile();
 
-          keypad.enableInterrupts();
+          KB().enableInterrupts();
 
           //Return to TXT_
           CurrentTXTState = TXT_;
@@ -996,9 +996,9 @@ void einkHandler_TXT_NEW() {
         display.fillRect(60,0,200,218,GxEPD_WHITE);
         display.drawBitmap(60,0,fileWizLiteallArray[0],200,218, GxEPD_BLACK);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < MAX_FILES; i++) {
           display.setCursor(88, 54+(17*i));
@@ -1064,9 +1064,9 @@ void einkHandler_TXT_NEW() {
         display.fillRect(60,0,200,218,GxEPD_WHITE);
         display.drawBitmap(60,0,fontfont0,200,218, GxEPD_BLACK);
 
-        keypad.disableInterrupts();
+        KB().disableInterrupts();
         listDir(SD_MMC, "/");
-        keypad.enableInterrupts();
+        KB().enableInterrupts();
 
         for (int i = 0; i < 7; i++) {
           display.setCursor(88, 54+(17*i));
@@ -50,7 +50,7 @@ const unsigned char *appIcons[11] = { _homeIcons2, _homeIcons3, _homeIcons4, _ho
 AppState CurrentAppState;             // Current app state
 
 // ===================== TASKS APP =====================
-std::vector<std::vector<String>> tasks;      // Task list
+std::vector<TaskRecord> tasks;               // Task list
 
 // ===================== HOME APP =====================
 HOMEState CurrentHOMEState = HOME_HOME;      // Current home state
\ No newline at end of file
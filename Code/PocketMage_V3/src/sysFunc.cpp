@@ -26,7 +26,7 @@ void saveFile() {
       Serial.println(textToSave);
     }
     if (editingFile == "" || editingFile == "-") editingFile = "/temp.txt";
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     if (!editingFile.startsWith("/")) editingFile = "/" + editingFile;
     oledWord("Saving File: "+ editingFile);
     writeFile(SD_MMC, (editingFile).c_str(), textToSave.c_str());
@@ -36,7 +36,7 @@ void saveFile() {
     writeMetadata(editingFile);
     
     delay(1000);
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
     SDActive = false;
   }
@@ -117,7 +117,7 @@ void loadFile(bool showOLED) {
     setCpuFrequencyMhz(240);
     delay(50);
 
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     if (showOLED) oledWord("Loading File");
     if (!editingFile.startsWith("/")) editingFile = "/" + editingFile;
     String textToLoad = readFileToString(SD_MMC, (editingFile).c_str());
@@ -126,7 +126,7 @@ void loadFile(bool showOLED) {
       Serial.println(textToLoad);
     }
     stringToVector(textToLoad);
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
     if (showOLED) oledWord("File Loaded");
     delay(200);
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
@@ -145,7 +145,7 @@ void delFile(String fileName) {
     setCpuFrequencyMhz(240);
     delay(50);
 
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     oledWord("Deleting File: "+ fileName);
     if (!fileName.startsWith("/")) fileName = "/" + fileName;
     deleteFile(SD_MMC, fileName.c_str());
@@ -155,7 +155,7 @@ void delFile(String fileName) {
     deleteMetadata(fileName);
 
     delay(1000);
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
     SDActive = false;
   }
@@ -211,7 +211,7 @@ void renFile(String oldFile, String newFile) {
     setCpuFrequencyMhz(240);
     delay(50);
 
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     oledWord("Renaming "+ oldFile + " to " + newFile);
     if (!oldFile.startsWith("/")) oldFile = "/" + oldFile;
     if (!newFile.startsWith("/")) newFile = "/" + newFile;
@@ -222,7 +222,7 @@ void renFile(String oldFile, String newFile) {
     // Update MetaData
     renMetadata(oldFile, newFile);
 
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
     SDActive = false;
   }
@@ -290,7 +290,7 @@ void copyFile(String oldFile, String newFile) {
     setCpuFrequencyMhz(240);
     delay(50);
 
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     oledWord("Loading File");
     if (!oldFile.startsWith("/")) oldFile = "/" + oldFile;
     if (!newFile.startsWith("/")) newFile = "/" + newFile;
@@ -302,7 +302,7 @@ void copyFile(String oldFile, String newFile) {
     writeMetadata(newFile);
 
     delay(1000);
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
     SDActive = false;
@@ -320,13 +320,13 @@ void appendToFile(String path, String inText) {
     setCpuFrequencyMhz(240);
     delay(50);
 
-    keypad.disableInterrupts();
+    KB().disableInterrupts();
     appendFile(SD_MMC, path.c_str(), inText.c_str());
 
     // Write MetaData
     writeMetadata(path);
 
-    keypad.enableInterrupts();
+    KB().enableInterrupts();
 
     if (SAVE_POWER) setCpuFrequencyMhz(POWER_SAVE_FREQ);
     SDActive = false;
@@ -640,7 +640,7 @@ void checkTimeout() {
             oledWord("Good Save!");
             delay(500);
             prevTimeMillis = millis();
-            keypad.flush();
+            KB().flush();
             return;
           }
         }
@@ -773,7 +773,7 @@ void checkTimeout() {
     else CurrentAppState = static_cast<AppState>(prefs.getInt("CurrentAppState", HOME));
     prefs.end();*/
     loadState();
-    keypad.flush();
+    KB().flush();
 
     CurrentHOMEState = HOME_HOME;
     PWR_BTN_event = false;
@@ -859,7 +859,7 @@ void loadState(bool changeState) {
     if (HOME_ON_BOOT) CurrentAppState = HOME;
     else CurrentAppState = static_cast<AppState>(prefs.getInt("CurrentAppState", HOME));
     
-    keypad.flush();
+    KB().flush();
 
     // Initialize boot app if needed
     switch (CurrentAppState) {
@@ -58,7 +58,10 @@ public:
     void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
     void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
-    
+    // Row-wise 1bpp blits straight into the emulator framebuffer
+    using Adafruit_GFX::drawBitmap;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) override;
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg) override;
     
     // Additional methods used by PocketMage
     void refresh(bool partial_update_mode = false);
@@ -75,6 +78,10 @@ private:
     GxEPD2_Type _panel;
     uint8_t _rotation = 0;
     bool _using_partial_mode = false;
+    uint16_t _pw_w = GxEPD2_Type::WIDTH;    // partial window size, for the panel model
+    uint16_t _pw_h = GxEPD2_Type::HEIGHT;
+    
+    void accountRefresh(bool partial, int w, int h);
     bool _initial_refresh = true;
 };
 
@@ -32,12 +32,17 @@
 #include <mutex>
 #include <cstdint>
 
-// Display dimensions (matching real hardware)
+// Display dimensions. The e-ink area is a 310x260 landscape canvas, not the
+// GDEQ031T10's native 240x320 portrait RAM that the device draws into under
+// setRotation(3), so e-ink buffers are not interchangeable with the device.
 #define EINK_WIDTH 310
 #define EINK_HEIGHT 260
 #define OLED_WIDTH 256
 #define OLED_HEIGHT 40  // Slightly taller than real 32px to prevent text cutoff
 
+// E-ink framebuffer row size in bytes (1 bit per pixel, rows padded to a byte)
+#define EINK_STRIDE ((EINK_WIDTH + 7) / 8)
+
 // Scale factor for visibility on desktop
 #define DISPLAY_SCALE 3
 
@@ -80,9 +85,18 @@ public:
     /** @return false if quit requested */
     bool handleEvents();
     
-    /** Present both displays to screen */
+    /** Block until an SDL event arrives or timeoutMs passes. @return true on event */
+    bool waitForEvent(uint32_t timeoutMs);
+    
+    /** Wake waitForEvent() from any thread */
+    void wake();
+    
+    /** Present both displays to screen, if a refresh happened or the window was exposed */
     void present();
     
+    uint32_t getEinkGeneration() const { return _einkGeneration; }
+    uint32_t getOledGeneration() const { return _oledGeneration; }
+    
     // ========== E-ink Display ==========
     void einkClear();
     void einkSetPixel(int x, int y, bool black);
@@ -91,6 +105,12 @@ public:
     void einkDrawCircle(int x, int y, int r, bool filled, bool black = true);
     void einkDrawText(const char* text, int x, int y, int fontSize = 12, bool inverted = false);
     void einkDrawBitmap(int x, int y, const unsigned char* bitmap, int w, int h, bool black = true);
+    
+    // Native fills / blits straight into the packed framebuffer, clipped once
+    void einkFillScreen(bool black);
+    void einkFillRect(int x, int y, int w, int h, bool black);
+    /** 1bpp MSB-first rows of (w + 7) / 8 bytes; bg < 0 leaves clear bits untouched */
+    void einkBlitBitmap(int x, int y, const uint8_t* bitmap, int w, int h, bool black, int bg = -1);
     void fillRect(int x, int y, int w, int h, uint32_t color);  // Generic fill rect
     void einkRefresh();
     void einkPartialRefresh();
@@ -118,7 +138,25 @@ public:
     bool hasUTF8Input();
     std::string getUTF8Input();
     
+    // Touch slider steps (mouse wheel), consumed by TOUCH()
+    int takeScrollSteps();
+    
+    // Input entry points used by handleEvents() and replay; all input is
+    // seen by the panel model and the recorder here
+    void injectKey(char key);
+    void injectText(const std::string& text);
+    void injectScroll(int steps);
+    
+    // Replay feeds input itself, so live keyboard/wheel input is dropped
+    void setLiveInputEnabled(bool enabled) { _liveInput = enabled; }
+    
     // ========== Framebuffer Access ==========
+    // E-ink uses GxEPD2's bit packing (EINK_STRIDE bytes per row, MSB =
+    // leftmost pixel, bit set = white) over the emulator's landscape
+    // EINK_WIDTH x EINK_HEIGHT canvas. That is not the device's native
+    // 240x320 layout, so hashes and dumps only compare against other
+    // emulator runs. OLED is 1 byte per pixel.
+    bool einkGetPixel(int x, int y) const;
     uint8_t* getEinkFramebuffer() { return _einkBuffer.data(); }
     uint8_t* getOledFramebuffer() { return _oledBuffer.data(); }
     const uint8_t* getEinkFramebuffer() const { return _einkBuffer.data(); }
@@ -145,13 +183,20 @@ private:
     TTF_Font* _fontLarge = nullptr;   // 16pt
     
     // ========== Framebuffers ==========
-    // 1 byte per pixel: 0=white/off, 1=black/on
-    std::vector<uint8_t> _einkBuffer;
-    std::vector<uint8_t> _oledBuffer;
+    std::vector<uint8_t> _einkBuffer;   // packed 1bpp, see getEinkFramebuffer()
+    std::vector<uint8_t> _oledBuffer;   // 1 byte per pixel: 0=off, 1=on
+    
+    // Changed pixels per e-ink row since the last texture upload
+    // (x0 > x1 means the row is clean)
+    std::vector<int16_t> _einkDirtyX0;
+    std::vector<int16_t> _einkDirtyX1;
+    std::vector<uint8_t> _einkUpload;   // RGB24 staging for SDL_UpdateTexture
     
     // ========== Input State ==========
     std::queue<char> _keyQueue;
     std::string _utf8Buffer;
+    int _scrollSteps = 0;
+    bool _liveInput = true;
     std::mutex _inputMutex;
     bool _shiftPressed = false;
     bool _ctrlPressed = false;
@@ -163,19 +208,31 @@ private:
     bool _needsOledRefresh = true;
     bool _einkFlashEnabled = true;  // E-ink refresh flash animation
     
+    // Bumped by each e-ink / OLED refresh; present() only composites when
+    // one has advanced past what is on screen, or the window was exposed
+    uint32_t _einkGeneration = 1;
+    uint32_t _oledGeneration = 1;
+    uint32_t _presentedEinkGeneration = 0;
+    uint32_t _presentedOledGeneration = 0;
+    bool _windowExposed = true;
+    uint32_t _wakeEventType = 0;    // SDL user event pushed by wake()
+    
     // ========== Helper Methods ==========
     void doEinkFlashAnimation();
     void updateEinkTexture();
+    void fillEinkTexture(uint8_t color);
     void updateOledTexture();
+    void plotEink(int x, int y, bool black);
+    void markEinkDirty(int x0, int x1, int y0, int y1);
+    void fillEinkSpan(int x0, int x1, int y, bool black);
+    bool writeEinkSpan(int x0, int x1, int y, bool black);
+    bool maskEinkByte(uint8_t* row, int byteIdx, uint8_t mask, bool black);
     char sdlKeyToChar(SDL_Keycode key, uint16_t mod);
     bool loadFonts();
     void renderTextToBuffer(const char* text, int x, int y, int fontSize, 
-                            std::vector<uint8_t>& buffer, int bufWidth, int bufHeight,
-                            bool inverted = false);
-    void drawLineImpl(int x0, int y0, int x1, int y1, bool black,
-                      std::vector<uint8_t>& buffer, int width, int height);
-    void drawCircleImpl(int cx, int cy, int r, bool filled, bool black,
-                        std::vector<uint8_t>& buffer, int width, int height);
+                            bool toEink, bool inverted = false);
+    void drawLineImpl(int x0, int y0, int x1, int y1, bool black);
+    void drawCircleImpl(int cx, int cy, int r, bool filled, bool black);
 };
 
 // Global display instance
@@ -0,0 +1,96 @@
+/**
+ * @file eink_panel_model.h
+ * @brief E-ink panel timing model for the desktop emulator
+ *
+ * The emulator redraws the e-ink area instantly. This model keeps a
+ * simulated panel timeline instead: every refresh the firmware would send
+ * to the GDEQ031T10 costs an SPI transfer (by window size) plus the
+ * waveform time of its refresh kind, and refreshes queue behind each
+ * other while the panel is busy. From that it reports keystroke-to-visible
+ * latency and panel-busy time per app. Nothing is delayed on the host.
+ */
+
+#ifndef EINK_PANEL_MODEL_H
+#define EINK_PANEL_MODEL_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+enum class EinkRefreshKind : uint8_t { FULL, FAST_FULL, PARTIAL, COUNT };
+
+// Durations are approximate GDEQ031T10 figures; override with --panel-timing
+struct EinkPanelTiming {
+    uint32_t fullMs     = 1600;     // slow full update (clears ghosting)
+    uint32_t fastFullMs = 800;      // fast full update (useFastFullUpdate)
+    uint32_t partialMs  = 400;      // partial window update
+    uint32_t spiHz      = 4000000;  // GxEPD2 default SPI clock
+};
+
+struct EinkPanelStats {
+    uint32_t refreshes[(int)EinkRefreshKind::COUNT] = {};
+    uint64_t spiBytes  = 0;
+    uint64_t busyMs    = 0;         // SPI + waveform time
+    uint32_t latencyCount = 0;      // keystrokes that reached the panel
+    uint64_t latencySumMs = 0;
+    uint32_t latencyMaxMs = 0;
+};
+
+class EinkPanelModel {
+public:
+    void setTiming(const EinkPanelTiming& timing) { timing_ = timing; }
+    const EinkPanelTiming& getTiming() const { return timing_; }
+
+    // Parse "full,fast,partial[,spiHz]" (ms); returns false if malformed
+    bool parseTiming(const char* spec);
+
+    // Attribute following refreshes to this app
+    void setApp(int id, const char* name);
+
+    // A key arrived; the next refresh that completes makes it visible
+    void noteInput();
+
+    // The app read the pending input this frame
+    void noteInputConsumed();
+
+    // End of a loop + e-ink handler pass. Input that was consumed but drew
+    // nothing is dropped, so it isn't charged to a later, unrelated refresh.
+    void endFrame();
+
+    /**
+     * Account one refresh of a w x h window (panel orientation).
+     * @return simulated duration (SPI + waveform) in ms
+     */
+    uint32_t refresh(EinkRefreshKind kind, int w, int h);
+
+    // Time the firmware blocks between refreshes (e.g. multiPassRefresh delays)
+    void hold(uint32_t ms);
+
+    // Simulated ms until the panel is idle again (0 if idle)
+    uint32_t busyFor() const;
+
+    const EinkPanelStats& getTotals() const { return totals_; }
+    void printStats() const;
+
+private:
+    struct AppEntry {
+        std::string name;
+        EinkPanelStats stats;
+    };
+
+    EinkPanelTiming timing_;
+    EinkPanelStats totals_;
+    std::map<int, AppEntry> apps_;
+    int app_ = -1;
+
+    uint64_t busyUntil_ = 0;        // host ms the panel finishes its queue
+    uint64_t inputAt_ = 0;
+    bool inputPending_ = false;
+    bool inputConsumed_ = false;    // pending input was read this frame
+    bool frameRefreshed_ = false;   // a refresh happened this frame
+};
+
+// Emulator-wide panel model
+EinkPanelModel& einkPanel();
+
+#endif // EINK_PANEL_MODEL_H
@@ -0,0 +1,87 @@
+/**
+ * @file cpu_power_model.h
+ * @brief CPU time-in-state and energy estimate for the desktop emulator
+ *
+ * The setCpuFrequencyMhz(), delay() and vTaskDelay() shims feed this model:
+ * host time is charged to the current CPU frequency while the firmware
+ * runs, and to idle while it delays or the main loop waits for work.
+ * Current draw is modelled as baseMa + maPerMhz * MHz when active and
+ * idleMa when idle, so changes to the frequency switching can be compared
+ * without a bench supply. Times are host times, not device cycle counts.
+ */
+
+#ifndef CPU_POWER_MODEL_H
+#define CPU_POWER_MODEL_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Rough ESP32-S3 figures; override with --cpu-power
+struct CpuPowerFigures {
+    float baseMa   = 12.0f;     // active current independent of clock
+    float maPerMhz = 0.2f;      // active current per MHz
+    float idleMa   = 2.0f;      // light sleep between loop ticks
+    float volts    = 3.7f;      // battery voltage for the mJ figure
+};
+
+class CpuPowerModel {
+public:
+    void setFigures(const CpuPowerFigures& figures) { figures_ = figures; }
+    const CpuPowerFigures& getFigures() const { return figures_; }
+
+    // Parse "baseMa,maPerMhz,idleMa[,volts]"; returns false if malformed
+    bool parseFigures(const char* spec);
+
+    void setFrequency(uint32_t mhz);
+    uint32_t getFrequency() const { return mhz_; }
+
+    // Bracket time the CPU would spend sleeping (may nest)
+    void beginIdle();
+    void endIdle();
+
+    // Charge following time to this app
+    void setApp(int id, const char* name);
+
+    void printStats();
+
+private:
+    struct Stats {
+        std::map<uint32_t, uint64_t> activeUs;  // by MHz
+        uint64_t idleUs = 0;
+        uint32_t transitions = 0;
+    };
+    struct AppEntry {
+        std::string name;
+        Stats stats;
+    };
+
+    void settle();
+    float energyMas(const Stats& s) const;
+    void printLine(const char* label, const Stats& s) const;
+
+    CpuPowerFigures figures_;
+    Stats totals_;
+    std::map<int, AppEntry> apps_;
+    int app_ = -1;
+
+    uint32_t mhz_ = 240;
+    int idleDepth_ = 0;
+    uint64_t markUs_ = 0;       // last time charged
+    std::recursive_mutex mutex_;
+};
+
+// Emulator-wide CPU model
+CpuPowerModel& cpuPower();
+
+// Marks the enclosing scope as CPU idle time
+class CpuIdleScope {
+public:
+    CpuIdleScope()  { cpuPower().beginIdle(); }
+    ~CpuIdleScope() { cpuPower().endIdle(); }
+    CpuIdleScope(const CpuIdleScope&) = delete;
+    CpuIdleScope& operator=(const CpuIdleScope&) = delete;
+};
+
+#endif // CPU_POWER_MODEL_H
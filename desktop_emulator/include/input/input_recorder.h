@@ -0,0 +1,89 @@
+/**
+ * @file input_recorder.h
+ * @brief Input session record / replay with per-frame framebuffer hashes
+ *
+ * Recording logs every key, text and touch-slider event that reaches the
+ * emulator together with the main loop frame it arrived in and the time.
+ * Replay feeds the same events back in the same frames, with live input
+ * disabled, so two builds can be compared on an identical interaction
+ * trace. Either mode can write a frame log: FNV-1a hashes of the e-ink and
+ * OLED framebuffers plus loop() / e-ink handler timings, one line for each
+ * frame that received input or changed a framebuffer.
+ *
+ * Trace format, one event per line:
+ *   <frame> <ms> K <hex char>
+ *   <frame> <ms> T <hex UTF-8 bytes>
+ *   <frame> <ms> S <steps>
+ *   <frame> <ms> Q              (end of session)
+ */
+
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class DesktopDisplay;
+
+class InputRecorder {
+public:
+    ~InputRecorder();
+
+    bool startRecording(const char* path);
+    bool startReplay(const char* path);
+    bool openFrameLog(const char* path);  // nullptr = stdout
+
+    bool isRecording() const { return _record != nullptr; }
+    bool isReplaying() const { return _replaying; }
+
+    // Live input, logged while recording
+    void onKey(char key);
+    void onText(const std::string& text);
+    void onScroll(int steps);
+
+    // Called each main loop iteration: beginFrame() after handleEvents()
+    // delivers replayed input, endFrame() logs hashes and advances the frame
+    void beginFrame(DesktopDisplay& display);
+    void endFrame(const DesktopDisplay& display, uint32_t loopUs, uint32_t einkUs);
+
+    // Replay has reached the recorded end of session
+    bool replayDone() const;
+
+    // Write the end marker / close files and print a summary
+    void finish();
+
+private:
+    struct Event {
+        uint32_t frame = 0;
+        uint32_t ms = 0;
+        char type = 0;      // K, T, S, Q
+        std::string data;   // key byte / UTF-8 text
+        int steps = 0;
+    };
+
+    void writeEvent(char type, const std::string& data, int steps);
+
+    FILE* _record = nullptr;
+    FILE* _frameLog = nullptr;
+    bool _replaying = false;
+    std::vector<Event> _events;
+    size_t _next = 0;
+    uint32_t _frame = 0;
+    uint32_t _startMs = 0;
+    bool _frameHadInput = false;
+
+    uint64_t _lastEinkHash = 0;
+    uint64_t _lastOledHash = 0;
+    uint32_t _loggedFrames = 0;
+    uint64_t _loopUs = 0;
+    uint64_t _einkUs = 0;
+    uint32_t _maxLoopUs = 0;
+    uint32_t _maxEinkUs = 0;
+};
+
+// Emulator-wide recorder
+InputRecorder& inputRecorder();
+
+#endif // INPUT_RECORDER_H
@@ -241,6 +241,12 @@ unsigned long millis();
 unsigned long micros();
 void delay(unsigned long ms);
 void delayMicroseconds(unsigned int us);
+// Emulator only: device time the host didn't spend (e.g. simulated SD bus)
+void chargeDeviceTime(unsigned long us);
+// Emulator only: in accelerated mode delay(), vTaskDelay(), delayMicroseconds()
+// and chargeDeviceTime() advance the virtual clock instead of sleeping
+void setClockAccelerated(bool accelerated);
+bool isClockAccelerated();
 void randomSeed(unsigned long seed);
 long random(long max);
 long random(long min, long max);
@@ -283,7 +289,7 @@ inline const T& max(const T& a, const T& b) {
     return (a > b) ? a : b;
 }
 
-inline uint32_t getCpuFrequencyMhz() { return 240; }
+uint32_t getCpuFrequencyMhz();
 void setCpuFrequencyMhz(uint32_t freq);
 
 // ============================================================================
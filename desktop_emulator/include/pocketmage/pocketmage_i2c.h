@@ -0,0 +1,11 @@
+/**
+ * @file pocketmage_i2c.h
+ * @brief Override header for PocketmageI2C - the emulator has no I2C bus
+ */
+
+#ifndef POCKETMAGE_I2C_H
+#define POCKETMAGE_I2C_H
+
+#include "pocketmage_stubs.h"
+
+#endif // POCKETMAGE_I2C_H
@@ -12,6 +12,7 @@
 #include "pocketmage_compat.h"
 #include "display/Adafruit_GFX.h"
 #include "storage/SD_MMC.h"
+#include <config.h>  // for FULL_REFRESH_AFTER
 
 // Forward declaration
 class DesktopDisplay;
@@ -22,7 +23,7 @@ extern DesktopDisplay* g_display;
 // ============================================================================
 class PocketmageEink {
 public:
-    PocketmageEink() : currentFont_(nullptr), fullRefreshAfter_(0), forceFullUpdate_(false) {}
+    PocketmageEink() : currentFont_(nullptr), fullRefreshAfter_(FULL_REFRESH_AFTER), forceFullUpdate_(false) {}
     
     void drawStatusBar(const String& text);
     void einkTextDynamic(bool fullRefresh, bool showCursor = false);
@@ -38,6 +39,7 @@ public:
 private:
     const GFXfont* currentFont_;
     int fullRefreshAfter_;
+    int partialCounter_ = 0;
     bool forceFullUpdate_;
 };
 
@@ -52,6 +54,8 @@ public:
     void oledLine(String text, bool selected = false, String suffix = "");
     void oledScroll();
     void oledWord(String text, bool selected = false, bool highlight = false);
+    void sendBuffer();
+    void invalidate() {}
 };
 
 // Keyboard states - defined in globals.h as KBState { NORMAL, SHIFT, FUNC }
@@ -68,6 +72,9 @@ public:
     
     int getKeyboardState() { return kbState_; }
     void setKeyboardState(int state) { kbState_ = state; }
+    void disableInterrupts() {}
+    void enableInterrupts() {}
+    void flush() {}
     
 private:
     int kbState_;
@@ -116,6 +123,9 @@ public:
     void setTimeoutMillis(long ms) { timeoutMillis_ = ms; }
     
     DateTime nowDT() const { return DateTime(); }
+    DateTime cachedNow() const { return DateTime(); }
+    void resync() {}
+    void adjust(const DateTime&) {}
     RTC_PCF8563& getRTC() { return *rtc_; }
     
 private:
@@ -137,13 +147,13 @@ public:
     void setDynamicScroll(int scroll) { dynamicScroll_ = scroll; }
     int getPrevDynamicScroll() { return prevDynamicScroll_; }
     void setPrevDynamicScroll(int scroll) { prevDynamicScroll_ = scroll; }
-    unsigned long getLastTouch() { return lastTouch_; }
-    void setLastTouch(unsigned long t) { lastTouch_ = t; }
+    int getLastTouch() const { return lastTouch_; }   // pad index, -1 when idle (as on the device)
+    void setLastTouch(int pad) { lastTouch_ = pad; }
     
 private:
     int dynamicScroll_;
     int prevDynamicScroll_;
-    unsigned long lastTouch_;
+    int lastTouch_ = -1;
 };
 
 // ============================================================================
@@ -229,12 +239,15 @@ namespace pocketmage {
     namespace file {
         void saveFile();
         void writeMetadata(const String& path);
+        void writeMetadata(const String& path, size_t fileSizeBytes, int charCount);
         void loadFile(bool showOLED = true);
         void delFile(String fileName);
         void deleteMetadata(String path);
         void renFile(String oldFile, String newFile);
         void renMetadata(String oldPath, String newPath);
-        void copyFile(String oldFile, String newFile);
+        typedef void (*CopyProgress)(size_t copied, size_t total);
+        bool copyFile(String oldFile, String newFile, bool verify = false,
+                      CopyProgress progress = nullptr);
         void appendToFile(String path, String inText);
     }
     
@@ -247,6 +260,9 @@ namespace pocketmage {
     namespace power {
         void deepSleep(bool alternateScreenSaver);
         void PWR_BTN_irq();
+        void wakeLoop();
+        void waitForLoopWork();
+        void waitForEinkWork();
         void updateBattState();
         void loadState(bool changeState);
     }
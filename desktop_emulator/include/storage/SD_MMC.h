@@ -3,14 +3,22 @@
  * @brief SD/MMC card library mock for desktop emulator
  * 
  * Uses std::filesystem to provide file operations on the local data/ directory.
+ * Metadata (existence, type, size, directory listings) is cached per path for
+ * the session and updated by writes, renames and removes made through this
+ * shim, so emulated code pays for its own I/O pattern rather than host
+ * syscalls. Files created in ./data by hand while running may not be seen.
+ *
+ * An optional cost model (SDCostModel) charges each operation the time a
+ * 1-bit SD_MMC card would take, since host SSD I/O is effectively free.
  */
 
 #ifndef SD_MMC_H
 #define SD_MMC_H
 
 #include "pocketmage/pocketmage_compat.h"
-#include <fstream>
+#include <cstdio>
 #include <filesystem>
+#include <vector>
 
 // Card types
 typedef enum {
@@ -21,6 +29,39 @@ typedef enum {
     CARD_UNKNOWN
 } sdcard_type_t;
 
+// Operations counted by the shim (see SD_MMCClass::getStats)
+enum SDOp {
+    SD_OP_OPEN = 0,
+    SD_OP_CLOSE,
+    SD_OP_READ,
+    SD_OP_WRITE,
+    SD_OP_SEEK,
+    SD_OP_STAT,     // exists() and metadata lookups on open
+    SD_OP_LIST,     // openNextFile()
+    SD_OP_REMOVE,
+    SD_OP_RENAME,
+    SD_OP_MKDIR,
+    SD_OP_COUNT
+};
+
+struct SDOpStats {
+    uint64_t calls = 0;      // calls made by emulated code
+    uint64_t bytes = 0;      // payload bytes (read / write)
+    uint64_t hostCalls = 0;  // host filesystem calls actually issued
+    uint64_t simUs = 0;      // simulated device time (cost model enabled)
+};
+
+// Device-cost model for a card on the 1-bit SD_MMC bus at 20 MHz. Sectors
+// are charged once per file while FATFS would still hold them in its
+// per-file window; simulated time is charged to the clock.
+struct SDCostModel {
+    bool     enabled      = false;
+    uint32_t lookupUs     = 800;     // FAT directory lookup, per path level
+    uint32_t readBlockUs  = 300;     // one 512 B sector read
+    uint32_t writeBlockUs = 1000;    // one sector write incl. card busy
+    uint32_t dirEntryUs   = 60;      // per entry from openNextFile()
+};
+
 // Forward declaration
 class File;
 
@@ -73,13 +114,34 @@ public:
     bool println() { return println(""); }
     
 private:
-    std::unique_ptr<std::ifstream> inFile;
-    std::unique_ptr<std::ofstream> outFile;
-    bool isOpen;
-    bool isDir;
-    std::string filePath;
-    std::vector<std::string> dirEntries;
-    size_t dirIndex;
+    static constexpr size_t READ_BUF_SIZE = 4096;
+    
+    FILE* fp = nullptr;           // host handle; read-only files open it on first read
+    bool isOpen = false;
+    bool isDir = false;
+    bool canRead = false;
+    bool canWrite = false;
+    bool appendMode = false;
+    std::string filePath;         // device path, e.g. "/sys/events.txt"
+    std::string hostPath;         // ./data/...
+    size_t pos = 0;               // logical file position
+    size_t hostPos = 0;           // host handle position, to skip redundant fseeks
+    size_t fileSize = 0;
+    std::vector<uint8_t> rbuf;    // one read buffer covering [rbufStart, rbufStart + rbufLen)
+    size_t rbufStart = 0;
+    size_t rbufLen = 0;
+    std::vector<std::string> dirEntries;  // device paths of children
+    size_t dirIndex = 0;
+    
+    bool openHost(const char* hostMode);
+    bool seekHost(size_t to, bool force = false);
+    bool fillReadBuffer();
+    void moveFrom(File& other);
+    
+    // Cost model: last sector touched and whether FAT/dirent need updating
+    size_t simSector = SIZE_MAX;
+    bool simDirty = false;
+    void chargeSectors(SDOp op, size_t from, size_t len);
 };
 
 // ============================================================================
@@ -148,6 +210,15 @@ public:
     bool rmdir(const char* path) override;
     bool rmdir(const String& path) override;
     
+    // I/O accounting
+    void setCostModel(const SDCostModel& model);
+    SDCostModel getCostModel() const;
+    // Enable the cost model, optionally from "lookupUs,readBlockUs,writeBlockUs,dirEntryUs"
+    bool parseCostModel(const char* spec);
+    SDOpStats getStats(SDOp op) const;
+    void resetStats();
+    void printStats() const;
+    
 private:
     bool _mounted;
     std::string _mountpoint;
@@ -9,6 +9,8 @@
  */
 
 #include "desktop_display_sdl2.h"
+#include "eink_panel_model.h"
+#include "input_recorder.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -22,8 +24,11 @@ DesktopDisplay* g_display = nullptr;
 // ============================================================================
 
 DesktopDisplay::DesktopDisplay() 
-    : _einkBuffer(EINK_WIDTH * EINK_HEIGHT, 0)  // 0 = white
-    , _oledBuffer(OLED_WIDTH * OLED_HEIGHT, 0)  // 0 = off
+    : _einkBuffer(EINK_STRIDE * EINK_HEIGHT, 0xFF)  // all bits set = white
+    , _oledBuffer(OLED_WIDTH * OLED_HEIGHT, 0)       // 0 = off
+    , _einkDirtyX0(EINK_HEIGHT, 0)
+    , _einkDirtyX1(EINK_HEIGHT, EINK_WIDTH - 1)      // first upload covers everything
+    , _einkUpload(EINK_WIDTH * EINK_HEIGHT * 3)
 {
 }
 
@@ -123,6 +128,9 @@ bool DesktopDisplay::init() {
         std::cerr << "[Display] Warning: Failed to load fonts, text rendering may not work" << std::endl;
     }
     
+    // Event type used by wake() to interrupt waitForEvent()
+    _wakeEventType = SDL_RegisterEvents(1);
+    
     // Clear displays
     einkClear();
     oledClear();
@@ -192,6 +200,10 @@ bool DesktopDisplay::handleEvents() {
                 if (event.window.event == SDL_WINDOWEVENT_CLOSE) {
                     return false;
                 }
+                if (event.window.event == SDL_WINDOWEVENT_EXPOSED ||
+                    event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                    _windowExposed = true;
+                }
                 break;
                 
             case SDL_KEYDOWN: {
@@ -202,10 +214,7 @@ bool DesktopDisplay::handleEvents() {
                 _altPressed = (mod & KMOD_ALT) != 0;
                 
                 char key = sdlKeyToChar(event.key.keysym.sym, mod);
-                if (key != 0) {
-                    std::lock_guard<std::mutex> lock(_inputMutex);
-                    _keyQueue.push(key);
-                }
+                if (key != 0 && _liveInput) injectKey(key);
                 break;
             }
             
@@ -215,18 +224,34 @@ bool DesktopDisplay::handleEvents() {
                 _altPressed = (event.key.keysym.mod & KMOD_ALT) != 0;
                 break;
                 
-            case SDL_TEXTINPUT: {
+            case SDL_TEXTINPUT:
                 // UTF-8 text input
-                std::lock_guard<std::mutex> lock(_inputMutex);
-                _utf8Buffer += event.text.text;
+                if (_liveInput) injectText(event.text.text);
+                break;
+                
+            case SDL_MOUSEWHEEL:
+                // Mouse wheel stands in for the capacitive touch slider
+                if (_liveInput && event.wheel.y != 0) injectScroll(event.wheel.y);
                 break;
-            }
         }
     }
     
     return true;
 }
 
+bool DesktopDisplay::waitForEvent(uint32_t timeoutMs) {
+    // NULL leaves the event queued for handleEvents()
+    return SDL_WaitEventTimeout(nullptr, (int)timeoutMs) != 0;
+}
+
+void DesktopDisplay::wake() {
+    if (!_initialized || _wakeEventType == (uint32_t)-1) return;
+    SDL_Event event;
+    SDL_memset(&event, 0, sizeof(event));
+    event.type = _wakeEventType;
+    SDL_PushEvent(&event);
+}
+
 char DesktopDisplay::sdlKeyToChar(SDL_Keycode key, uint16_t mod) {
     bool shift = (mod & KMOD_SHIFT) != 0;
     (void)mod;  // ctrl not currently used
@@ -306,6 +331,7 @@ char DesktopDisplay::getLastKey() {
     if (_keyQueue.empty()) return 0;
     char key = _keyQueue.front();
     _keyQueue.pop();
+    einkPanel().noteInputConsumed();
     return key;
 }
 
@@ -328,9 +354,46 @@ std::string DesktopDisplay::getUTF8Input() {
     std::lock_guard<std::mutex> lock(_inputMutex);
     std::string result = _utf8Buffer;
     _utf8Buffer.clear();
+    if (!result.empty()) einkPanel().noteInputConsumed();
     return result;
 }
 
+int DesktopDisplay::takeScrollSteps() {
+    std::lock_guard<std::mutex> lock(_inputMutex);
+    const int steps = _scrollSteps;
+    _scrollSteps = 0;
+    if (steps) einkPanel().noteInputConsumed();
+    return steps;
+}
+
+void DesktopDisplay::injectKey(char key) {
+    {
+        std::lock_guard<std::mutex> lock(_inputMutex);
+        _keyQueue.push(key);
+    }
+    einkPanel().noteInput();
+    inputRecorder().onKey(key);
+}
+
+void DesktopDisplay::injectText(const std::string& text) {
+    if (text.empty()) return;
+    {
+        std::lock_guard<std::mutex> lock(_inputMutex);
+        _utf8Buffer += text;
+    }
+    einkPanel().noteInput();
+    inputRecorder().onText(text);
+}
+
+void DesktopDisplay::injectScroll(int steps) {
+    {
+        std::lock_guard<std::mutex> lock(_inputMutex);
+        _scrollSteps += steps;
+    }
+    einkPanel().noteInput();
+    inputRecorder().onScroll(steps);
+}
+
 // ============================================================================
 // Rendering
 // ============================================================================
@@ -338,18 +401,26 @@ std::string DesktopDisplay::getUTF8Input() {
 void DesktopDisplay::present() {
     if (!_initialized) return;
     
+    const bool einkChanged = _einkGeneration != _presentedEinkGeneration;
+    const bool oledChanged = _oledGeneration != _presentedOledGeneration;
+    if (!einkChanged && !oledChanged && !_windowExposed) return;
+    
     // Update E-ink texture if needed
-    if (_needsEinkRefresh) {
+    if (einkChanged && _needsEinkRefresh) {
         updateEinkTexture();
         _needsEinkRefresh = false;
     }
     
     // Update OLED texture if needed
-    if (_needsOledRefresh) {
+    if (oledChanged && _needsOledRefresh) {
         updateOledTexture();
         _needsOledRefresh = false;
     }
     
+    _presentedEinkGeneration = _einkGeneration;
+    _presentedOledGeneration = _oledGeneration;
+    _windowExposed = false;
+    
     // Clear with black background
     SDL_SetRenderDrawColor(_einkRenderer, 0, 0, 0, 255);
     SDL_RenderClear(_einkRenderer);
@@ -375,43 +446,51 @@ void DesktopDisplay::present() {
     SDL_RenderPresent(_einkRenderer);
 }
 
+// Upload only the rows/columns that changed. Consecutive dirty rows are
+// merged into one rectangle spanning their combined columns.
 void DesktopDisplay::updateEinkTexture() {
     if (!_einkTexture) return;
     
-    void* pixels;
-    int pitch;
-    
-    if (SDL_LockTexture(_einkTexture, nullptr, &pixels, &pitch) != 0) {
-        std::cerr << "[Display] Failed to lock E-ink texture" << std::endl;
-        return;
-    }
-    
-    uint8_t* dst = static_cast<uint8_t*>(pixels);
-    
-    // Debug: count black pixels
-    static int debugCounter = 0;
-    int blackPixels = 0;
-    
-    for (int y = 0; y < EINK_HEIGHT; y++) {
-        for (int x = 0; x < EINK_WIDTH; x++) {
-            int srcIdx = y * EINK_WIDTH + x;
-            int dstIdx = y * pitch + x * 3;
-            
-            // E-ink: 0 = white, 1 = black
-            uint8_t color = _einkBuffer[srcIdx] ? 0x00 : 0xFF;
-            if (_einkBuffer[srcIdx]) blackPixels++;
-            dst[dstIdx + 0] = color;  // R
-            dst[dstIdx + 1] = color;  // G
-            dst[dstIdx + 2] = color;  // B
+    int y = 0;
+    while (y < EINK_HEIGHT) {
+        if (_einkDirtyX0[y] > _einkDirtyX1[y]) { y++; continue; }
+        
+        int y0 = y;
+        int x0 = _einkDirtyX0[y];
+        int x1 = _einkDirtyX1[y];
+        while (y < EINK_HEIGHT && _einkDirtyX0[y] <= _einkDirtyX1[y]) {
+            x0 = std::min<int>(x0, _einkDirtyX0[y]);
+            x1 = std::max<int>(x1, _einkDirtyX1[y]);
+            _einkDirtyX0[y] = EINK_WIDTH;  // clean
+            _einkDirtyX1[y] = -1;
+            y++;
         }
+        
+        const int w = x1 - x0 + 1;
+        const int pitch = w * 3;
+        for (int ry = y0; ry < y; ry++) {
+            const uint8_t* row = &_einkBuffer[ry * EINK_STRIDE];
+            uint8_t* dst = &_einkUpload[(ry - y0) * pitch];
+            for (int x = x0; x <= x1; x++) {
+                // E-ink: bit set = white, clear = black
+                const uint8_t color = (row[x >> 3] & (0x80 >> (x & 7))) ? 0xFF : 0x00;
+                *dst++ = color;  // R
+                *dst++ = color;  // G
+                *dst++ = color;  // B
+            }
+        }
+        
+        SDL_Rect rect = { x0, y0, w, y - y0 };
+        SDL_UpdateTexture(_einkTexture, &rect, _einkUpload.data(), pitch);
     }
-    
-    // Print debug info every 100 updates
-    if (debugCounter++ % 100 == 0) {
-        std::cout << "[Display] E-ink update: " << blackPixels << " black pixels" << std::endl;
-    }
-    
-    SDL_UnlockTexture(_einkTexture);
+}
+
+// Paint the whole e-ink texture one color without touching the framebuffer
+void DesktopDisplay::fillEinkTexture(uint8_t color) {
+    if (!_einkTexture) return;
+    std::fill(_einkUpload.begin(), _einkUpload.end(), color);
+    SDL_UpdateTexture(_einkTexture, nullptr, _einkUpload.data(), EINK_WIDTH * 3);
+    markEinkDirty(0, EINK_WIDTH - 1, 0, EINK_HEIGHT - 1);  // restore on next upload
 }
 
 void DesktopDisplay::updateOledTexture() {
@@ -452,24 +531,152 @@ void DesktopDisplay::updateOledTexture() {
 // E-ink Display Operations
 // ============================================================================
 
-void DesktopDisplay::einkClear() {
-    std::fill(_einkBuffer.begin(), _einkBuffer.end(), 0);  // 0 = white
+void DesktopDisplay::markEinkDirty(int x0, int x1, int y0, int y1) {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, EINK_WIDTH - 1);
+    y0 = std::max(y0, 0);
+    y1 = std::min(y1, EINK_HEIGHT - 1);
+    if (x0 > x1) return;
+    for (int y = y0; y <= y1; y++) {
+        if (x0 < _einkDirtyX0[y]) _einkDirtyX0[y] = x0;
+        if (x1 > _einkDirtyX1[y]) _einkDirtyX1[y] = x1;
+    }
+}
+
+void DesktopDisplay::plotEink(int x, int y, bool black) {
+    if (x < 0 || x >= EINK_WIDTH || y < 0 || y >= EINK_HEIGHT) return;
+    uint8_t& byte = _einkBuffer[y * EINK_STRIDE + (x >> 3)];
+    const uint8_t mask = 0x80 >> (x & 7);
+    const uint8_t old = byte;
+    if (black) byte &= ~mask;
+    else       byte |= mask;
+    if (byte != old) {
+        if (x < _einkDirtyX0[y]) _einkDirtyX0[y] = x;
+        if (x > _einkDirtyX1[y]) _einkDirtyX1[y] = x;
+    }
+}
+
+// Set or clear the mask bits of one framebuffer byte. @return true if it changed
+bool DesktopDisplay::maskEinkByte(uint8_t* row, int byteIdx, uint8_t mask, bool black) {
+    const uint8_t old = row[byteIdx];
+    row[byteIdx] = black ? (old & ~mask) : (old | mask);
+    return row[byteIdx] != old;
+}
+
+// Set pixels x0..x1 (inclusive, already clipped) of row y: partial head
+// byte, whole middle bytes, partial tail byte. @return true if anything changed
+bool DesktopDisplay::writeEinkSpan(int x0, int x1, int y, bool black) {
+    uint8_t* row = &_einkBuffer[y * EINK_STRIDE];
+    const int b0 = x0 >> 3;
+    const int b1 = x1 >> 3;
+    const uint8_t headMask = 0xFF >> (x0 & 7);
+    const uint8_t tailMask = 0xFF << (7 - (x1 & 7));
+    
+    if (b0 == b1) return maskEinkByte(row, b0, headMask & tailMask, black);
+    
+    bool changed = maskEinkByte(row, b0, headMask, black);
+    const uint8_t fill = black ? 0x00 : 0xFF;
+    for (int b = b0 + 1; b < b1; b++) {
+        if (row[b] != fill) { row[b] = fill; changed = true; }
+    }
+    changed |= maskEinkByte(row, b1, tailMask, black);
+    return changed;
+}
+
+// Set pixels x0..x1 (inclusive, clipped) of row y
+void DesktopDisplay::fillEinkSpan(int x0, int x1, int y, bool black) {
+    if (y < 0 || y >= EINK_HEIGHT) return;
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, EINK_WIDTH - 1);
+    if (x0 > x1) return;
+    if (writeEinkSpan(x0, x1, y, black)) markEinkDirty(x0, x1, y, y);
+}
+
+void DesktopDisplay::einkFillRect(int x, int y, int w, int h, bool black) {
+    const int x0 = std::max(x, 0);
+    const int x1 = std::min(x + w - 1, EINK_WIDTH - 1);
+    const int y0 = std::max(y, 0);
+    const int y1 = std::min(y + h - 1, EINK_HEIGHT - 1);
+    if (x0 > x1 || y0 > y1) return;
+    
+    for (int py = y0; py <= y1; py++) {
+        if (writeEinkSpan(x0, x1, py, black)) markEinkDirty(x0, x1, py, py);
+    }
     _needsEinkRefresh = true;
 }
 
+void DesktopDisplay::einkFillScreen(bool black) {
+    einkFillRect(0, 0, EINK_WIDTH, EINK_HEIGHT, black);
+}
+
+// Row-wise blit: each source byte is shifted into (at most) two
+// framebuffer bytes, with edge bits masked off once per byte
+void DesktopDisplay::einkBlitBitmap(int x, int y, const uint8_t* bitmap, int w, int h,
+                                    bool black, int bg) {
+    if (!bitmap || w <= 0 || h <= 0) return;
+    const int byteWidth = (w + 7) / 8;
+    const int cx0 = std::max(x, 0);
+    const int cx1 = std::min(x + w - 1, EINK_WIDTH - 1);
+    const int cy0 = std::max(y, 0);
+    const int cy1 = std::min(y + h - 1, EINK_HEIGHT - 1);
+    if (cx0 > cx1 || cy0 > cy1) return;
+    
+    const int sb0 = (cx0 - x) >> 3;
+    const int sb1 = (cx1 - x) >> 3;
+    
+    for (int py = cy0; py <= cy1; py++) {
+        const uint8_t* src = bitmap + (py - y) * byteWidth;
+        uint8_t* row = &_einkBuffer[py * EINK_STRIDE];
+        bool changed = false;
+        
+        for (int sb = sb0; sb <= sb1; sb++) {
+            // Bits of this source byte that land inside the clip
+            const int dx = x + sb * 8;  // x of the byte's MSB
+            uint8_t visible = 0xFF;
+            if (dx < cx0) visible &= 0xFF >> (cx0 - dx);
+            if (dx + 7 > cx1) visible &= 0xFF << (dx + 7 - cx1);
+            
+            const uint8_t fg = src[sb] & visible;
+            const uint8_t back = (uint8_t)~src[sb] & visible;
+            
+            // dx can be negative only when its leading bits are clipped away
+            const int byteIdx = (dx >= 0) ? (dx >> 3) : -1;
+            const int shift = dx & 7;
+            auto apply = [&](uint8_t bits, bool toBlack) {
+                if (!bits) return;
+                const uint16_t wide = (uint16_t)(bits << 8) >> shift;
+                if (byteIdx >= 0 && (wide >> 8)) changed |= maskEinkByte(row, byteIdx, wide >> 8, toBlack);
+                if (byteIdx + 1 < EINK_STRIDE && (wide & 0xFF)) changed |= maskEinkByte(row, byteIdx + 1, wide & 0xFF, toBlack);
+            };
+            apply(fg, black);
+            if (bg >= 0) apply(back, bg != 0);
+        }
+        
+        if (changed) markEinkDirty(cx0, cx1, py, py);
+    }
+    _needsEinkRefresh = true;
+}
+
+bool DesktopDisplay::einkGetPixel(int x, int y) const {
+    if (x < 0 || x >= EINK_WIDTH || y < 0 || y >= EINK_HEIGHT) return false;
+    return !(_einkBuffer[y * EINK_STRIDE + (x >> 3)] & (0x80 >> (x & 7)));
+}
+
+void DesktopDisplay::einkClear() {
+    einkFillScreen(false);
+}
+
 void DesktopDisplay::einkSetPixel(int x, int y, bool black) {
-    if (x < 0 || x >= EINK_WIDTH || y < 0 || y >= EINK_HEIGHT) return;
-    _einkBuffer[y * EINK_WIDTH + x] = black ? 1 : 0;
+    plotEink(x, y, black);
     _needsEinkRefresh = true;
 }
 
 void DesktopDisplay::einkDrawLine(int x0, int y0, int x1, int y1, bool black) {
-    drawLineImpl(x0, y0, x1, y1, black, _einkBuffer, EINK_WIDTH, EINK_HEIGHT);
+    drawLineImpl(x0, y0, x1, y1, black);
     _needsEinkRefresh = true;
 }
 
-void DesktopDisplay::drawLineImpl(int x0, int y0, int x1, int y1, bool black,
-                                   std::vector<uint8_t>& buffer, int width, int height) {
+void DesktopDisplay::drawLineImpl(int x0, int y0, int x1, int y1, bool black) {
     // Bresenham's line algorithm
     int dx = std::abs(x1 - x0);
     int dy = std::abs(y1 - y0);
@@ -478,9 +685,7 @@ void DesktopDisplay::drawLineImpl(int x0, int y0, int x1, int y1, bool black,
     int err = dx - dy;
     
     while (true) {
-        if (x0 >= 0 && x0 < width && y0 >= 0 && y0 < height) {
-            buffer[y0 * width + x0] = black ? 1 : 0;
-        }
+        plotEink(x0, y0, black);
         
         if (x0 == x1 && y0 == y1) break;
         
@@ -497,61 +702,38 @@ void DesktopDisplay::fillRect(int x, int y, int w, int h, uint32_t color) {
 }
 
 void DesktopDisplay::einkDrawRect(int x, int y, int w, int h, bool filled, bool black) {
+    if (w <= 0 || h <= 0) return;
     if (filled) {
-        for (int py = y; py < y + h; py++) {
-            for (int px = x; px < x + w; px++) {
-                if (px >= 0 && px < EINK_WIDTH && py >= 0 && py < EINK_HEIGHT) {
-                    _einkBuffer[py * EINK_WIDTH + px] = black ? 1 : 0;
-                }
-            }
-        }
+        einkFillRect(x, y, w, h, black);
     } else {
         // Top and bottom edges
-        for (int px = x; px < x + w; px++) {
-            if (px >= 0 && px < EINK_WIDTH) {
-                if (y >= 0 && y < EINK_HEIGHT)
-                    _einkBuffer[y * EINK_WIDTH + px] = black ? 1 : 0;
-                if (y + h - 1 >= 0 && y + h - 1 < EINK_HEIGHT)
-                    _einkBuffer[(y + h - 1) * EINK_WIDTH + px] = black ? 1 : 0;
-            }
-        }
+        fillEinkSpan(x, x + w - 1, y, black);
+        fillEinkSpan(x, x + w - 1, y + h - 1, black);
         // Left and right edges
         for (int py = y; py < y + h; py++) {
-            if (py >= 0 && py < EINK_HEIGHT) {
-                if (x >= 0 && x < EINK_WIDTH)
-                    _einkBuffer[py * EINK_WIDTH + x] = black ? 1 : 0;
-                if (x + w - 1 >= 0 && x + w - 1 < EINK_WIDTH)
-                    _einkBuffer[py * EINK_WIDTH + (x + w - 1)] = black ? 1 : 0;
-            }
+            plotEink(x, py, black);
+            plotEink(x + w - 1, py, black);
         }
     }
     _needsEinkRefresh = true;
 }
 
 void DesktopDisplay::einkDrawCircle(int cx, int cy, int r, bool filled, bool black) {
-    drawCircleImpl(cx, cy, r, filled, black, _einkBuffer, EINK_WIDTH, EINK_HEIGHT);
+    drawCircleImpl(cx, cy, r, filled, black);
     _needsEinkRefresh = true;
 }
 
-void DesktopDisplay::drawCircleImpl(int cx, int cy, int r, bool filled, bool black,
-                                     std::vector<uint8_t>& buffer, int width, int height) {
+void DesktopDisplay::drawCircleImpl(int cx, int cy, int r, bool filled, bool black) {
     // Midpoint circle algorithm
     int x = r;
     int y = 0;
     int err = 0;
     
-    auto setPixel = [&](int px, int py) {
-        if (px >= 0 && px < width && py >= 0 && py < height) {
-            buffer[py * width + px] = black ? 1 : 0;
-        }
-    };
+    auto setPixel = [&](int px, int py) { plotEink(px, py, black); };
     
     auto drawHLine = [&](int x1, int x2, int py) {
-        if (py < 0 || py >= height) return;
         if (x1 > x2) std::swap(x1, x2);
-        for (int px = std::max(0, x1); px <= std::min(width - 1, x2); px++) {
-            buffer[py * width + px] = black ? 1 : 0;
-        }
+        fillEinkSpan(x1, x2, py, black);
     };
     
     while (x >= y) {
@@ -584,13 +766,21 @@ void DesktopDisplay::drawCircleImpl(int cx, int cy, int r, bool filled, bool bla
 
 void DesktopDisplay::einkDrawText(const char* text, int x, int y, int fontSize, bool inverted) {
     if (!text || !text[0]) return;
-    renderTextToBuffer(text, x, y, fontSize, _einkBuffer, EINK_WIDTH, EINK_HEIGHT, inverted);
+    renderTextToBuffer(text, x, y, fontSize, true, inverted);
     _needsEinkRefresh = true;
 }
 
 void DesktopDisplay::renderTextToBuffer(const char* text, int x, int y, int fontSize,
-                                         std::vector<uint8_t>& buffer, int bufWidth, int bufHeight,
-                                         bool inverted) {
+                                         bool toEink, bool inverted) {
+    const int bufWidth = toEink ? EINK_WIDTH : OLED_WIDTH;
+    const int bufHeight = toEink ? EINK_HEIGHT : OLED_HEIGHT;
+    
+    // 1 = black (e-ink) / on (OLED), 0 = white / off
+    auto plot = [&](int bx, int by, bool on) {
+        if (toEink) plotEink(bx, by, on);
+        else _oledBuffer[by * bufWidth + bx] = on ? 1 : 0;
+    };
+    
     TTF_Font* font = nullptr;
     if (fontSize <= 10) font = _fontSmall;
     else if (fontSize <= 14) font = _fontMedium;
@@ -608,7 +798,7 @@ void DesktopDisplay::renderTextToBuffer(const char* text, int x, int y, int font
                     int bx = cx + px;
                     int by = y + py;
                     if (bx >= 0 && bx < bufWidth && by >= 0 && by < bufHeight) {
-                        buffer[by * bufWidth + bx] = inverted ? 1 : 0;  // 1 = black, 0 = white
+                        plot(bx, by, inverted);
                     }
                 }
             }
@@ -637,7 +827,7 @@ void DesktopDisplay::renderTextToBuffer(const char* text, int x, int y, int font
             uint8_t pixel = pixels[py * surface->pitch + px];
             
             if (pixel) {
-                buffer[by * bufWidth + bx] = inverted ? 1 : 0;  // 1 = black, 0 = white
+                plot(bx, by, inverted);
             }
         }
     }
@@ -647,28 +837,8 @@ void DesktopDisplay::renderTextToBuffer(const char* text, int x, int y, int font
 }
 
 void DesktopDisplay::einkDrawBitmap(int x, int y, const unsigned char* bitmap, int w, int h, bool black) {
-    if (!bitmap) return;
-    
-    // Bitmap is stored as 1 bit per pixel, MSB first
-    int byteWidth = (w + 7) / 8;
-    
-    for (int py = 0; py < h; py++) {
-        for (int px = 0; px < w; px++) {
-            int byteIdx = py * byteWidth + px / 8;
-            int bitIdx = 7 - (px % 8);
-            bool pixelSet = (bitmap[byteIdx] >> bitIdx) & 1;
-            
-            int bx = x + px;
-            int by = y + py;
-            
-            if (bx >= 0 && bx < EINK_WIDTH && by >= 0 && by < EINK_HEIGHT) {
-                if (pixelSet) {
-                    _einkBuffer[by * EINK_WIDTH + bx] = black ? 1 : 0;
-                }
-            }
-        }
-    }
-    _needsEinkRefresh = true;
+    // Bitmap is stored as 1 bit per pixel, MSB first; clear bits are transparent
+    einkBlitBitmap(x, y, bitmap, w, h, black);
 }
 
 void DesktopDisplay::einkRefresh() {
@@ -677,11 +847,13 @@ void DesktopDisplay::einkRefresh() {
         doEinkFlashAnimation();
     }
     _needsEinkRefresh = true;
+    _einkGeneration++;
 }
 
 void DesktopDisplay::einkPartialRefresh() {
     // Partial refresh - no flash animation (faster update)
     _needsEinkRefresh = true;
+    _einkGeneration++;
 }
 
 void DesktopDisplay::einkForceFullRefresh() {
@@ -690,14 +862,12 @@ void DesktopDisplay::einkForceFullRefresh() {
         doEinkFlashAnimation();
     }
     _needsEinkRefresh = true;
+    _einkGeneration++;
 }
 
 void DesktopDisplay::doEinkFlashAnimation() {
     if (!_einkTexture || !_einkRenderer) return;
     
-    // Save current buffer
-    std::vector<uint8_t> savedBuffer = _einkBuffer;
-    
     SDL_Rect einkDest = {
         EINK_OFFSET_X,
         EINK_OFFSET_Y,
@@ -709,8 +879,7 @@ void DesktopDisplay::doEinkFlashAnimation() {
     // This simulates real e-ink refresh behavior
     for (int flash = 0; flash < 2; flash++) {
         // Fill black
-        std::fill(_einkBuffer.begin(), _einkBuffer.end(), 1);
-        updateEinkTexture();
+        fillEinkTexture(0x00);
         SDL_SetRenderDrawColor(_einkRenderer, 0, 0, 0, 255);
         SDL_RenderClear(_einkRenderer);
         SDL_RenderCopy(_einkRenderer, _einkTexture, nullptr, &einkDest);
@@ -727,8 +896,7 @@ void DesktopDisplay::doEinkFlashAnimation() {
         SDL_Delay(50);  // 50ms black
         
         // Fill white
-        std::fill(_einkBuffer.begin(), _einkBuffer.end(), 0);
-        updateEinkTexture();
+        fillEinkTexture(0xFF);
         SDL_SetRenderDrawColor(_einkRenderer, 0, 0, 0, 255);
         SDL_RenderClear(_einkRenderer);
         SDL_RenderCopy(_einkRenderer, _einkTexture, nullptr, &einkDest);
@@ -737,8 +905,9 @@ void DesktopDisplay::doEinkFlashAnimation() {
         SDL_Delay(50);  // 50ms white
     }
     
-    // Restore original buffer
-    _einkBuffer = savedBuffer;
+    // fillEinkTexture() left the whole panel dirty, so the next
+    // present() uploads the real image again
+    _needsEinkRefresh = true;
 }
 
 void DesktopDisplay::setEinkFlashEnabled(bool enabled) {
@@ -815,7 +984,7 @@ void DesktopDisplay::oledDrawText(const char* text, int x, int y, int fontSize)
     if (adjustedY < 0) adjustedY = 0;
     
     // OLED: inverted=true means pixels ON (white/colored text on black background)
-    renderTextToBuffer(text, x, adjustedY, fontSize, _oledBuffer, OLED_WIDTH, OLED_HEIGHT, true);
+    renderTextToBuffer(text, x, adjustedY, fontSize, false, true);
     _needsOledRefresh = true;
 }
 
@@ -838,4 +1007,5 @@ int DesktopDisplay::oledGetTextWidth(const char* text, int fontSize) {
 
 void DesktopDisplay::oledRefresh() {
     _needsOledRefresh = true;
+    _oledGeneration++;
 }
@@ -0,0 +1,126 @@
+/**
+ * @file eink_panel_model.cpp
+ * @brief E-ink panel timing model implementation
+ */
+
+#include "eink_panel_model.h"
+#include "pocketmage_compat.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+static EinkPanelModel s_panel;
+
+EinkPanelModel& einkPanel() { return s_panel; }
+
+bool EinkPanelModel::parseTiming(const char* spec) {
+    unsigned long full = 0, fast = 0, partial = 0, spi = timing_.spiHz;
+    const int n = spec ? sscanf(spec, "%lu,%lu,%lu,%lu", &full, &fast, &partial, &spi) : 0;
+    if (n < 3 || spi == 0) return false;
+
+    timing_.fullMs     = (uint32_t)full;
+    timing_.fastFullMs = (uint32_t)fast;
+    timing_.partialMs  = (uint32_t)partial;
+    timing_.spiHz      = (uint32_t)spi;
+    return true;
+}
+
+void EinkPanelModel::setApp(int id, const char* name) {
+    if (id == app_) return;
+    app_ = id;
+    AppEntry& entry = apps_[id];
+    if (entry.name.empty() && name) entry.name = name;
+}
+
+void EinkPanelModel::noteInput() {
+    // Latency counts from the first key the panel hasn't shown yet
+    if (inputPending_) return;
+    inputPending_ = true;
+    inputAt_ = millis();
+}
+
+void EinkPanelModel::noteInputConsumed() {
+    if (inputPending_) inputConsumed_ = true;
+}
+
+void EinkPanelModel::endFrame() {
+    if (inputConsumed_ && !frameRefreshed_) inputPending_ = false;
+    inputConsumed_ = false;
+    frameRefreshed_ = false;
+}
+
+uint32_t EinkPanelModel::refresh(EinkRefreshKind kind, int w, int h) {
+    if (w <= 0 || h <= 0) return 0;
+
+    // GxEPD2 writes the window to both the current and previous RAM
+    const uint64_t bytes = 2ULL * ((w + 7) / 8) * h;
+    const uint32_t spiMs = (uint32_t)(bytes * 8 * 1000 / timing_.spiHz);
+
+    uint32_t waveMs = timing_.partialMs;
+    if (kind == EinkRefreshKind::FULL)           waveMs = timing_.fullMs;
+    else if (kind == EinkRefreshKind::FAST_FULL) waveMs = timing_.fastFullMs;
+    const uint32_t duration = spiMs + waveMs;
+
+    // Queue behind whatever the panel is still doing
+    const uint64_t now = millis();
+    busyUntil_ = std::max<uint64_t>(busyUntil_, now) + duration;
+    frameRefreshed_ = true;
+
+    EinkPanelStats* targets[2] = { &totals_, app_ >= 0 ? &apps_[app_].stats : nullptr };
+    for (EinkPanelStats* s : targets) {
+        if (!s) continue;
+        s->refreshes[(int)kind]++;
+        s->spiBytes += bytes;
+        s->busyMs   += duration;
+    }
+
+    if (inputPending_) {
+        inputPending_ = false;
+        const uint32_t latency = (uint32_t)(busyUntil_ - inputAt_);
+        for (EinkPanelStats* s : targets) {
+            if (!s) continue;
+            s->latencyCount++;
+            s->latencySumMs += latency;
+            s->latencyMaxMs = std::max(s->latencyMaxMs, latency);
+        }
+    }
+
+    return duration;
+}
+
+void EinkPanelModel::hold(uint32_t ms) {
+    busyUntil_ = std::max<uint64_t>(busyUntil_, millis()) + ms;
+}
+
+uint32_t EinkPanelModel::busyFor() const {
+    const uint64_t now = millis();
+    return busyUntil_ > now ? (uint32_t)(busyUntil_ - now) : 0;
+}
+
+static void printLine(const char* label, const EinkPanelStats& s) {
+    char buf[192];
+    snprintf(buf, sizeof(buf),
+             "  %-12s full %4u  fast %4u  partial %5u  busy %7.1fs  SPI %6lluKB  key->visible avg %4ums max %5ums",
+             label,
+             s.refreshes[(int)EinkRefreshKind::FULL],
+             s.refreshes[(int)EinkRefreshKind::FAST_FULL],
+             s.refreshes[(int)EinkRefreshKind::PARTIAL],
+             s.busyMs / 1000.0,
+             (unsigned long long)(s.spiBytes / 1024),
+             s.latencyCount ? (unsigned)(s.latencySumMs / s.latencyCount) : 0u,
+             s.latencyMaxMs);
+    std::cout << buf << std::endl;
+}
+
+void EinkPanelModel::printStats() const {
+    std::cout << "[Panel] Simulated e-ink time (full " << timing_.fullMs
+              << "ms, fast " << timing_.fastFullMs
+              << "ms, partial " << timing_.partialMs
+              << "ms, SPI " << timing_.spiHz / 1000 << "kHz):" << std::endl;
+    for (const auto& it : apps_) {
+        const EinkPanelStats& s = it.second.stats;
+        if (s.busyMs == 0 && s.latencyCount == 0) continue;
+        printLine(it.second.name.c_str(), s);
+    }
+    printLine("total", totals_);
+}
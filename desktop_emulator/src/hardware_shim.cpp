@@ -20,11 +20,17 @@
 #include "U8g2lib.h"
 #include "USB.h"
 #include "esp_log.h"
+#include "cpu_power_model.h"
 
 #include <iostream>
 #include <chrono>
 #include <thread>
 #include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
 
 // ============================================================================
 // Global Instances
@@ -116,24 +122,54 @@ const uint8_t u8g2_font_ncenB24_tr[] = {0};
 // Timing Functions
 // ============================================================================
 
+// Virtual clock: host time since start plus time skipped by accelerated
+// sleeps. In real-time mode nothing is skipped and this is the wall clock.
 static auto s_startTime = std::chrono::steady_clock::now();
+static std::atomic<uint64_t> s_skippedUs{0};
+static std::atomic<bool> s_accelerated{false};
 
-unsigned long millis() {
+static uint64_t virtualMicros() {
     auto now = std::chrono::steady_clock::now();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(now - s_startTime).count();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - s_startTime).count() + s_skippedUs;
+}
+
+// Let time pass: instantly when accelerated, otherwise on the host
+static void passTime(uint64_t us) {
+    if (s_accelerated) {
+        s_skippedUs += us;
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+void setClockAccelerated(bool accelerated) {
+    s_accelerated = accelerated;
+}
+
+bool isClockAccelerated() {
+    return s_accelerated;
+}
+
+unsigned long millis() {
+    return (unsigned long)(virtualMicros() / 1000);
 }
 
 unsigned long micros() {
-    auto now = std::chrono::steady_clock::now();
-    return std::chrono::duration_cast<std::chrono::microseconds>(now - s_startTime).count();
+    return (unsigned long)virtualMicros();
 }
 
 void delay(unsigned long ms) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    CpuIdleScope idle;
+    passTime((uint64_t)ms * 1000);
 }
 
 void delayMicroseconds(unsigned int us) {
-    std::this_thread::sleep_for(std::chrono::microseconds(us));
+    passTime(us);
+}
+
+void chargeDeviceTime(unsigned long us) {
+    // The device stays busy (not idle) while it waits on the bus
+    passTime(us);
 }
 
 // ============================================================================
@@ -203,8 +239,116 @@ int digitalPinToInterrupt(uint8_t pin) {
 // CPU Functions
 // ============================================================================
 
+static CpuPowerModel s_cpuPower;
+
+CpuPowerModel& cpuPower() { return s_cpuPower; }
+
 void setCpuFrequencyMhz(uint32_t freq) {
-    // Mock - no CPU frequency control on desktop
+    // No CPU frequency control on desktop; record it for the power model
+    s_cpuPower.setFrequency(freq);
+}
+
+uint32_t getCpuFrequencyMhz() {
+    return s_cpuPower.getFrequency();
+}
+
+bool CpuPowerModel::parseFigures(const char* spec) {
+    CpuPowerFigures f = figures_;
+    const int n = spec ? sscanf(spec, "%f,%f,%f,%f", &f.baseMa, &f.maPerMhz, &f.idleMa, &f.volts) : 0;
+    if (n < 3) return false;
+    figures_ = f;
+    return true;
+}
+
+// Charge the time since the last mark to the current state
+void CpuPowerModel::settle() {
+    const uint64_t now = micros();
+    const uint64_t us = now - markUs_;
+    markUs_ = now;
+    if (us == 0) return;
+
+    Stats* targets[2] = { &totals_, app_ >= 0 ? &apps_[app_].stats : nullptr };
+    for (Stats* s : targets) {
+        if (!s) continue;
+        if (idleDepth_ > 0) s->idleUs += us;
+        else                s->activeUs[mhz_] += us;
+    }
+}
+
+void CpuPowerModel::setFrequency(uint32_t mhz) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (mhz == mhz_) return;
+    settle();
+    mhz_ = mhz;
+    totals_.transitions++;
+    if (app_ >= 0) apps_[app_].stats.transitions++;
+}
+
+// settle() runs before the depth changes so it charges the state just left
+void CpuPowerModel::beginIdle() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (idleDepth_ == 0) settle();
+    idleDepth_++;
+}
+
+void CpuPowerModel::endIdle() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (idleDepth_ == 0) return;
+    if (idleDepth_ == 1) settle();
+    idleDepth_--;
+}
+
+void CpuPowerModel::setApp(int id, const char* name) {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (id == app_) return;
+    settle();
+    app_ = id;
+    AppEntry& entry = apps_[id];
+    if (entry.name.empty() && name) entry.name = name;
+}
+
+// Charge in mA*s
+float CpuPowerModel::energyMas(const Stats& s) const {
+    float mas = figures_.idleMa * (s.idleUs / 1e6f);
+    for (const auto& it : s.activeUs) {
+        mas += (figures_.baseMa + figures_.maPerMhz * it.first) * (it.second / 1e6f);
+    }
+    return mas;
+}
+
+void CpuPowerModel::printLine(const char* label, const Stats& s) const {
+    uint64_t activeUs = 0;
+    std::string perFreq;
+    for (const auto& it : s.activeUs) {
+        activeUs += it.second;
+        char part[32];
+        snprintf(part, sizeof(part), " %uMHz %.1fs", (unsigned)it.first, it.second / 1e6);
+        perFreq += part;
+    }
+    const uint64_t totalUs = activeUs + s.idleUs;
+    const float mas = energyMas(s);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+             "  %-12s idle %7.1fs %s  switches %5u  avg %5.1fmA  %7.3fmAh  %8.1fmJ",
+             label, s.idleUs / 1e6, perFreq.c_str(), s.transitions,
+             totalUs ? mas / (totalUs / 1e6f) : 0.0f,
+             mas / 3600.0f,
+             mas * figures_.volts);
+    std::cout << buf << std::endl;
+}
+
+void CpuPowerModel::printStats() {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    settle();
+    char buf[160];
+    snprintf(buf, sizeof(buf), "[CPU] Time in state (%.1fmA + %.2fmA/MHz active, %.1fmA idle, %.1fV):",
+             figures_.baseMa, figures_.maPerMhz, figures_.idleMa, figures_.volts);
+    std::cout << buf << std::endl;
+    for (const auto& it : apps_) {
+        printLine(it.second.name.c_str(), it.second.stats);
+    }
+    printLine("total", totals_);
 }
 
 // ============================================================================
@@ -315,55 +459,192 @@ void playJingle(const char* name) {
 }
 
 // ============================================================================
-// SD_MMC File Implementation
+// SD_MMC Metadata Cache and Accounting
 // ============================================================================
 
-File::File() : inFile(nullptr), outFile(nullptr), isOpen(false), isDir(false), dirIndex(0) {}
+namespace {
 
-File::File(const std::string& path, const std::string& mode) 
-    : inFile(nullptr), outFile(nullptr), isOpen(false), isDir(false), filePath(path), dirIndex(0) {
+struct StatEntry {
+    bool exists = false;
+    bool isDir = false;
+    size_t size = 0;
+    bool listed = false;                  // children valid
+    std::vector<std::string> children;    // device paths
+};
+
+std::unordered_map<std::string, StatEntry> s_statCache;
+SDOpStats s_sdStats[SD_OP_COUNT];
+SDCostModel s_sdCost;
+std::recursive_mutex s_sdMutex;
+
+const char* const SD_OP_NAMES[SD_OP_COUNT] = {
+    "open", "close", "read", "write", "seek", "stat", "list", "remove", "rename", "mkdir"
+};
+
+// "/a/b", no trailing slash, "/" for the root
+std::string devicePath(const std::string& path) {
+    std::string p = path;
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    while (p.size() > 1 && p.back() == '/') p.pop_back();
+    return p;
+}
+
+std::string hostPathOf(const std::string& dev) {
+    return dev == "/" ? "./data" : "./data" + dev;
+}
+
+std::string parentOf(const std::string& dev) {
+    size_t slash = dev.find_last_of('/');
+    return slash == 0 ? "/" : dev.substr(0, slash);
+}
+
+void countOp(SDOp op, uint64_t bytes = 0, uint64_t hostCalls = 0) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    s_sdStats[op].calls++;
+    s_sdStats[op].bytes += bytes;
+    s_sdStats[op].hostCalls += hostCalls;
+}
+
+void countHost(SDOp op, uint64_t hostCalls = 1) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    s_sdStats[op].hostCalls += hostCalls;
+}
+
+// Cost model: charge simulated device time to an op and to the clock
+void chargeOp(SDOp op, uint64_t us) {
+    if (!s_sdCost.enabled || us == 0) return;
+    {
+        std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+        s_sdStats[op].simUs += us;
+    }
+    chargeDeviceTime((unsigned long)us);
+}
+
+// FAT walks one directory per path level, whether or not we cached it
+uint64_t lookupCost(const std::string& dev) {
+    uint64_t levels = 0;
+    for (char c : dev) levels += (c == '/');
+    return (uint64_t)s_sdCost.lookupUs * std::max<uint64_t>(levels, 1);
+}
+
+// Cached metadata for a device path, stat'ing the host only on a miss
+StatEntry& statPath(const std::string& dev, SDOp op) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    auto it = s_statCache.find(dev);
+    if (it != s_statCache.end()) return it->second;
     
-    // Normalize path - remove leading slash and prepend data directory
-    std::string localPath = path;
-    if (!localPath.empty() && localPath[0] == '/') {
-        localPath = localPath.substr(1);
+    StatEntry entry;
+    std::error_code ec;
+    auto st = std::filesystem::status(hostPathOf(dev), ec);
+    if (!ec && std::filesystem::exists(st)) {
+        entry.exists = true;
+        entry.isDir = std::filesystem::is_directory(st);
+        if (!entry.isDir) entry.size = (size_t)std::filesystem::file_size(hostPathOf(dev), ec);
+    }
+    countHost(op);
+    return s_statCache.emplace(dev, std::move(entry)).first->second;
+}
+
+const std::vector<std::string>& listPath(const std::string& dev) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    StatEntry& entry = statPath(dev, SD_OP_LIST);
+    if (!entry.listed) {
+        entry.children.clear();
+        std::error_code ec;
+        for (const auto& child : std::filesystem::directory_iterator(hostPathOf(dev), ec)) {
+            std::string name = child.path().filename().string();
+            entry.children.push_back(dev == "/" ? "/" + name : dev + "/" + name);
+        }
+        entry.listed = true;
+        countHost(SD_OP_LIST);
+    }
+    return entry.children;
+}
+
+// Forget a path (and anything under it) and its parent's listing
+void invalidatePath(const std::string& dev) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    const std::string prefix = dev + "/";
+    for (auto it = s_statCache.begin(); it != s_statCache.end();) {
+        if (it->first == dev || it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = s_statCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    if (dev != "/") {
+        auto parent = s_statCache.find(parentOf(dev));
+        if (parent != s_statCache.end()) {
+            parent->second.listed = false;
+            parent->second.children.clear();
+        }
     }
-    std::string fullPath = "./data/" + localPath;
+}
+
+// A file written through the shim: keep its entry current without a stat
+void noteFileSize(const std::string& dev, size_t size) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    auto it = s_statCache.find(dev);
+    if (it == s_statCache.end() || !it->second.exists) {
+        invalidatePath(dev);  // new file: parent listing changes
+        StatEntry entry;
+        entry.exists = true;
+        s_statCache[dev] = entry;
+        it = s_statCache.find(dev);
+    }
+    it->second.size = size;
+}
+
+}  // namespace
+
+// ============================================================================
+// SD_MMC File Implementation
+// ============================================================================
+
+File::File() {}
+
+File::File(const std::string& path, const std::string& mode) 
+    : filePath(devicePath(path)), hostPath(hostPathOf(devicePath(path))) {
+    countOp(SD_OP_OPEN);
+    const bool writeMode = (mode == "w" || mode == FILE_WRITE || mode == "a" || mode == FILE_APPEND);
+    // Creating or truncating also rewrites the directory entry
+    chargeOp(SD_OP_OPEN, lookupCost(filePath) + (writeMode ? s_sdCost.writeBlockUs : 0));
     
     try {
-        std::filesystem::path p(fullPath);
+        const StatEntry st = statPath(filePath, SD_OP_OPEN);
         
-        if (std::filesystem::exists(p) && std::filesystem::is_directory(p)) {
+        if (st.exists && st.isDir) {
             // Directory handle
             isDir = true;
             isOpen = true;
             dirIndex = 0;
-            dirEntries.clear();
-            
-            for (const auto& entry : std::filesystem::directory_iterator(p)) {
-                dirEntries.push_back(entry.path().string());
-            }
-        } else {
-            isDir = false;
-            
+            dirEntries = listPath(filePath);
+        } else if (mode == "r" || mode == FILE_READ) {
+            // Opened on first read, so open/size()/close never touches the host
+            isOpen = st.exists;
+            canRead = true;
+            fileSize = st.size;
+        } else if (writeMode) {
             // Ensure parent directory exists for write modes
-            if (mode == "w" || mode == FILE_WRITE || mode == "a" || mode == FILE_APPEND) {
-                std::filesystem::create_directories(p.parent_path());
-            }
-            
-            if (mode == "r" || mode == FILE_READ) {
-                inFile = std::make_unique<std::ifstream>(fullPath, std::ios::binary);
-                isOpen = inFile && inFile->is_open();
-            } else if (mode == "w" || mode == FILE_WRITE) {
-                outFile = std::make_unique<std::ofstream>(fullPath, std::ios::binary | std::ios::trunc);
-                isOpen = outFile && outFile->is_open();
-            } else if (mode == "a" || mode == FILE_APPEND) {
-                outFile = std::make_unique<std::ofstream>(fullPath, std::ios::binary | std::ios::app);
-                isOpen = outFile && outFile->is_open();
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(hostPath).parent_path(), ec);
+            appendMode = (mode == "a" || mode == FILE_APPEND);
+            const size_t existing = st.exists ? st.size : 0;
+            isOpen = openHost(appendMode ? "ab" : "wb");
+            canWrite = isOpen;
+            if (isOpen) {
+                fileSize = appendMode ? existing : 0;
+                pos = hostPos = fileSize;
+                noteFileSize(filePath, fileSize);
             }
+        } else if (mode == "r+") {
+            // Overwrite in place: no truncation, fails if the file is missing
+            isOpen = st.exists && openHost("r+b");
+            canRead = canWrite = isOpen;
+            fileSize = st.size;
         }
     } catch (const std::exception& e) {
-        std::cerr << "[File] Error opening " << fullPath << ": " << e.what() << std::endl;
+        std::cerr << "[File] Error opening " << hostPath << ": " << e.what() << std::endl;
         isOpen = false;
     }
 }
@@ -372,48 +653,119 @@ File::~File() {
     close();
 }
 
-File::File(File&& other) noexcept
-    : inFile(std::move(other.inFile))
-    , outFile(std::move(other.outFile))
-    , isOpen(other.isOpen)
-    , isDir(other.isDir)
-    , filePath(std::move(other.filePath))
-    , dirEntries(std::move(other.dirEntries))
-    , dirIndex(other.dirIndex)
-{
+void File::moveFrom(File& other) {
+    fp = other.fp;
+    isOpen = other.isOpen;
+    isDir = other.isDir;
+    canRead = other.canRead;
+    canWrite = other.canWrite;
+    appendMode = other.appendMode;
+    filePath = std::move(other.filePath);
+    hostPath = std::move(other.hostPath);
+    pos = other.pos;
+    hostPos = other.hostPos;
+    fileSize = other.fileSize;
+    rbuf = std::move(other.rbuf);
+    rbufStart = other.rbufStart;
+    rbufLen = other.rbufLen;
+    dirEntries = std::move(other.dirEntries);
+    dirIndex = other.dirIndex;
+    simSector = other.simSector;
+    simDirty = other.simDirty;
+    
+    other.fp = nullptr;
     other.isOpen = false;
     other.isDir = false;
+    other.canRead = other.canWrite = false;
+    other.rbufLen = 0;
     other.dirIndex = 0;
+    other.simDirty = false;
+}
+
+File::File(File&& other) noexcept {
+    moveFrom(other);
 }
 
 File& File::operator=(File&& other) noexcept {
     if (this != &other) {
         close();
-        inFile = std::move(other.inFile);
-        outFile = std::move(other.outFile);
-        isOpen = other.isOpen;
-        isDir = other.isDir;
-        filePath = std::move(other.filePath);
-        dirEntries = std::move(other.dirEntries);
-        dirIndex = other.dirIndex;
-        
-        other.isOpen = false;
-        other.isDir = false;
-        other.dirIndex = 0;
+        moveFrom(other);
     }
     return *this;
 }
 
+bool File::openHost(const char* hostMode) {
+    fp = std::fopen(hostPath.c_str(), hostMode);
+    countHost(SD_OP_OPEN);
+    // Reads go through rbuf only; writes keep stdio buffering
+    if (fp && std::strcmp(hostMode, "rb") == 0) std::setvbuf(fp, nullptr, _IONBF, 0);
+    hostPos = 0;
+    return fp != nullptr;
+}
+
+// force: "r+" handles must seek between reads and writes (C stdio rule)
+bool File::seekHost(size_t to, bool force) {
+    if (hostPos == to && !force) return true;
+    countHost(SD_OP_SEEK);
+    if (std::fseek(fp, (long)to, SEEK_SET) != 0) return false;
+    hostPos = to;
+    return true;
+}
+
+bool File::fillReadBuffer() {
+    if (!fp && !(isOpen && openHost("rb"))) return false;
+    if (!seekHost(pos, canWrite)) return false;
+    rbuf.resize(READ_BUF_SIZE);
+    rbufStart = pos;
+    rbufLen = std::fread(rbuf.data(), 1, READ_BUF_SIZE, fp);
+    hostPos = pos + rbufLen;
+    countHost(SD_OP_READ);
+    return rbufLen > 0;
+}
+
+// Charge the sectors [from, from + len) touches, except the one FATFS
+// still holds in its per-file window from the previous access
+void File::chargeSectors(SDOp op, size_t from, size_t len) {
+    if (!s_sdCost.enabled || len == 0) return;
+    const size_t first = from / 512;
+    const size_t last = (from + len - 1) / 512;
+    size_t sectors = last - first + 1;
+    if (first == simSector) sectors--;
+    simSector = last;
+    chargeOp(op, (uint64_t)sectors * (op == SD_OP_WRITE ? s_sdCost.writeBlockUs : s_sdCost.readBlockUs));
+}
+
 void File::close() {
-    if (inFile) { inFile->close(); inFile.reset(); }
-    if (outFile) { outFile->close(); outFile.reset(); }
+    if (isOpen) countOp(SD_OP_CLOSE, 0, fp ? 1 : 0);
+    // Sync updates the FAT and the directory entry
+    if (simDirty) chargeOp(SD_OP_CLOSE, 2ULL * s_sdCost.writeBlockUs);
+    simDirty = false;
+    if (fp) { std::fclose(fp); fp = nullptr; }
+    rbufLen = 0;
     isOpen = false;
 }
 
 size_t File::write(const uint8_t* data, size_t len) {
-    if (!outFile || !outFile->is_open() || !data) return 0;
-    outFile->write(reinterpret_cast<const char*>(data), len);
-    return outFile->good() ? len : 0;
+    if (!canWrite || !fp || !data) return 0;
+    if (appendMode) pos = fileSize;
+    
+    size_t written = 0;
+    if (seekHost(pos, canRead)) {
+        written = std::fwrite(data, 1, len, fp);
+        countHost(SD_OP_WRITE);
+        hostPos = pos + written;
+    }
+    countOp(SD_OP_WRITE, written);
+    chargeSectors(SD_OP_WRITE, pos, written);
+    if (written) simDirty = true;
+    
+    // Drop buffered bytes this write overlapped
+    if (rbufLen && pos < rbufStart + rbufLen && pos + written > rbufStart) rbufLen = 0;
+    
+    pos += written;
+    if (pos > fileSize) fileSize = pos;
+    noteFileSize(filePath, fileSize);
+    return written == len ? len : 0;
 }
 
 size_t File::write(const String& str) {
@@ -421,53 +773,87 @@ size_t File::write(const String& str) {
 }
 
 int File::read() {
-    if (!inFile || !inFile->is_open()) return -1;
-    return inFile->get();
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
 }
 
 size_t File::read(uint8_t* buf, size_t size) {
-    if (!inFile || !inFile->is_open() || !buf) return 0;
-    inFile->read(reinterpret_cast<char*>(buf), size);
-    return inFile->gcount();
+    if (!canRead || !isOpen || !buf) return 0;
+    
+    const size_t start = pos;
+    size_t done = 0;
+    while (done < size && pos < fileSize) {
+        if (pos < rbufStart || pos >= rbufStart + rbufLen) {
+            // Large reads bypass the buffer
+            if (size - done >= READ_BUF_SIZE) {
+                if (!fp && !openHost("rb")) break;
+                if (!seekHost(pos, canWrite)) break;
+                const size_t got = std::fread(buf + done, 1, size - done, fp);
+                countHost(SD_OP_READ);
+                hostPos = pos + got;
+                done += got;
+                pos += got;
+                break;
+            }
+            if (!fillReadBuffer()) break;
+        }
+        const size_t offset = pos - rbufStart;
+        const size_t n = std::min(size - done, rbufLen - offset);
+        std::memcpy(buf + done, rbuf.data() + offset, n);
+        done += n;
+        pos += n;
+    }
+    countOp(SD_OP_READ, done);
+    chargeSectors(SD_OP_READ, start, done);
+    return done;
 }
 
 String File::readString() {
-    if (!inFile || !inFile->is_open()) return String("");
-    std::string result((std::istreambuf_iterator<char>(*inFile)), std::istreambuf_iterator<char>());
+    if (!canRead || !isOpen) return String("");
+    std::string result(fileSize > pos ? fileSize - pos : 0, '\0');
+    result.resize(read(reinterpret_cast<uint8_t*>(&result[0]), result.size()));
     return String(result.c_str());
 }
 
 String File::readStringUntil(char terminator) {
-    if (!inFile || !inFile->is_open()) {
+    if (!canRead || !isOpen) {
         return String("");
     }
     std::string result;
-    std::getline(*inFile, result, terminator);
+    const size_t start = pos;
+    size_t consumed = 0;
+    while (pos < fileSize) {
+        if (pos < rbufStart || pos >= rbufStart + rbufLen) {
+            if (!fillReadBuffer()) break;
+        }
+        const uint8_t* start = rbuf.data() + (pos - rbufStart);
+        const size_t avail = rbufStart + rbufLen - pos;
+        const uint8_t* hit = static_cast<const uint8_t*>(std::memchr(start, terminator, avail));
+        const size_t n = hit ? (size_t)(hit - start) : avail;
+        result.append(reinterpret_cast<const char*>(start), n);
+        pos += n;
+        consumed += n;
+        if (hit) { pos++; consumed++; break; }  // drop the terminator
+    }
+    countOp(SD_OP_READ, consumed);
+    chargeSectors(SD_OP_READ, start, consumed);
     return String(result.c_str());
 }
 
 bool File::available() {
-    if (!inFile || !inFile->is_open()) return false;
-    return inFile->peek() != EOF;
+    return canRead && isOpen && pos < fileSize;
 }
 
-void File::seek(size_t pos) {
-    if (inFile && inFile->is_open()) inFile->seekg(pos);
-    if (outFile && outFile->is_open()) outFile->seekp(pos);
+void File::seek(size_t newPos) {
+    countOp(SD_OP_SEEK);
+    pos = newPos;  // the host handle follows on the next read/write
 }
 
 size_t File::position() {
-    if (inFile && inFile->is_open()) return inFile->tellg();
-    if (outFile && outFile->is_open()) return outFile->tellp();
-    return 0;
+    return pos;
 }
 
 size_t File::size() {
-    if (!inFile || !inFile->is_open()) return 0;
-    auto current = inFile->tellg();
-    inFile->seekg(0, std::ios::end);
-    auto fileSize = inFile->tellg();
-    inFile->seekg(current);
     return fileSize;
 }
 
@@ -477,16 +863,9 @@ bool File::isDirectory() {
 
 File File::openNextFile() {
     if (!isDir || dirIndex >= dirEntries.size()) return File();
-    
-    std::string childPath = dirEntries[dirIndex++];
-    
-    // Convert to relative path
-    const std::string prefix = "./data/";
-    if (childPath.find(prefix) == 0) {
-        childPath = "/" + childPath.substr(prefix.length());
-    }
-    
-    return File(childPath, "r");
+    countOp(SD_OP_LIST);
+    chargeOp(SD_OP_LIST, s_sdCost.dirEntryUs);
+    return File(dirEntries[dirIndex++], "r");
 }
 
 void File::rewindDirectory() {
@@ -507,9 +886,10 @@ String File::path() {
 }
 
 bool File::print(const char* msg) {
-    if (!outFile || !outFile->is_open()) return false;
-    if (msg) *outFile << msg;
-    return outFile->good();
+    if (!canWrite) return false;
+    if (!msg) return true;
+    const size_t len = strlen(msg);
+    return write(reinterpret_cast<const uint8_t*>(msg), len) == len;
 }
 
 bool File::print(const String& msg) {
@@ -517,10 +897,8 @@ bool File::print(const String& msg) {
 }
 
 bool File::println(const char* msg) {
-    if (!outFile || !outFile->is_open()) return false;
-    if (msg) *outFile << msg;
-    *outFile << '\n';
-    return outFile->good();
+    if (!print(msg)) return false;
+    return write(reinterpret_cast<const uint8_t*>("\n"), 1) == 1;
 }
 
 bool File::println(const String& msg) {
@@ -533,9 +911,7 @@ bool File::println(const String& msg) {
 
 std::string SD_MMCClass::toLocalPath(const char* path) {
     if (!path) return "./data";
-    std::string p = path;
-    if (!p.empty() && p[0] == '/') p = p.substr(1);
-    return "./data/" + p;
+    return hostPathOf(devicePath(path));
 }
 
 File SD_MMCClass::open(const char* path, const char* mode) {
@@ -549,7 +925,9 @@ File SD_MMCClass::open(const String& path, const char* mode) {
 
 bool SD_MMCClass::exists(const char* path) {
     if (!path) return false;
-    return std::filesystem::exists(toLocalPath(path));
+    countOp(SD_OP_STAT);
+    chargeOp(SD_OP_STAT, lookupCost(devicePath(path)));
+    return statPath(devicePath(path), SD_OP_STAT).exists;
 }
 
 bool SD_MMCClass::exists(const String& path) {
@@ -558,8 +936,12 @@ bool SD_MMCClass::exists(const String& path) {
 
 bool SD_MMCClass::remove(const char* path) {
     if (!path) return false;
+    countOp(SD_OP_REMOVE, 0, 1);
+    chargeOp(SD_OP_REMOVE, lookupCost(devicePath(path)) + 2ULL * s_sdCost.writeBlockUs);
     std::error_code ec;
-    return std::filesystem::remove(toLocalPath(path), ec);
+    const bool ok = std::filesystem::remove(toLocalPath(path), ec);
+    invalidatePath(devicePath(path));
+    return ok;
 }
 
 bool SD_MMCClass::remove(const String& path) {
@@ -568,8 +950,13 @@ bool SD_MMCClass::remove(const String& path) {
 
 bool SD_MMCClass::rename(const char* pathFrom, const char* pathTo) {
     if (!pathFrom || !pathTo) return false;
+    countOp(SD_OP_RENAME, 0, 1);
+    chargeOp(SD_OP_RENAME, lookupCost(devicePath(pathFrom)) + lookupCost(devicePath(pathTo)) +
+                           2ULL * s_sdCost.writeBlockUs);
     std::error_code ec;
     std::filesystem::rename(toLocalPath(pathFrom), toLocalPath(pathTo), ec);
+    invalidatePath(devicePath(pathFrom));
+    invalidatePath(devicePath(pathTo));
     return !ec;
 }
 
@@ -579,9 +966,17 @@ bool SD_MMCClass::rename(const String& pathFrom, const String& pathTo) {
 
 bool SD_MMCClass::mkdir(const char* path) {
     if (!path) return false;
+    countOp(SD_OP_MKDIR, 0, 1);
+    // Directory entry, FAT and the new directory's first cluster
+    chargeOp(SD_OP_MKDIR, lookupCost(devicePath(path)) + 3ULL * s_sdCost.writeBlockUs);
     std::error_code ec;
-    return std::filesystem::create_directories(toLocalPath(path), ec) || 
-           std::filesystem::exists(toLocalPath(path));
+    const bool ok = std::filesystem::create_directories(toLocalPath(path), ec) || 
+                    std::filesystem::exists(toLocalPath(path));
+    // create_directories may have made several levels
+    for (std::string dev = devicePath(path); dev != "/"; dev = parentOf(dev)) {
+        invalidatePath(dev);
+    }
+    return ok;
 }
 
 bool SD_MMCClass::mkdir(const String& path) {
@@ -590,14 +985,75 @@ bool SD_MMCClass::mkdir(const String& path) {
 
 bool SD_MMCClass::rmdir(const char* path) {
     if (!path) return false;
+    countOp(SD_OP_REMOVE, 0, 1);
+    chargeOp(SD_OP_REMOVE, lookupCost(devicePath(path)) + 2ULL * s_sdCost.writeBlockUs);
     std::error_code ec;
-    return std::filesystem::remove_all(toLocalPath(path), ec) > 0;
+    const bool ok = std::filesystem::remove_all(toLocalPath(path), ec) > 0;
+    invalidatePath(devicePath(path));
+    return ok;
 }
 
 bool SD_MMCClass::rmdir(const String& path) {
     return rmdir(path.c_str());
 }
 
+void SD_MMCClass::setCostModel(const SDCostModel& model) {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    s_sdCost = model;
+}
+
+SDCostModel SD_MMCClass::getCostModel() const {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    return s_sdCost;
+}
+
+bool SD_MMCClass::parseCostModel(const char* spec) {
+    SDCostModel model = getCostModel();
+    model.enabled = true;
+    if (spec && *spec) {
+        unsigned long lookup, rd, wr, dirent;
+        if (sscanf(spec, "%lu,%lu,%lu,%lu", &lookup, &rd, &wr, &dirent) != 4) return false;
+        model.lookupUs = (uint32_t)lookup;
+        model.readBlockUs = (uint32_t)rd;
+        model.writeBlockUs = (uint32_t)wr;
+        model.dirEntryUs = (uint32_t)dirent;
+    }
+    setCostModel(model);
+    return true;
+}
+
+SDOpStats SD_MMCClass::getStats(SDOp op) const {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    return s_sdStats[op];
+}
+
+void SD_MMCClass::resetStats() {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    for (auto& stats : s_sdStats) stats = SDOpStats();
+}
+
+void SD_MMCClass::printStats() const {
+    std::lock_guard<std::recursive_mutex> lock(s_sdMutex);
+    std::cout << "[SD] op       calls      bytes  host calls" << (s_sdCost.enabled ? "   sim ms" : "") << std::endl;
+    uint64_t simUs = 0;
+    for (int op = 0; op < SD_OP_COUNT; op++) {
+        const SDOpStats& st = s_sdStats[op];
+        if (st.calls == 0 && st.hostCalls == 0) continue;
+        char line[96];
+        int len = snprintf(line, sizeof(line), "[SD] %-6s %8llu %10llu %11llu", SD_OP_NAMES[op],
+                           (unsigned long long)st.calls, (unsigned long long)st.bytes,
+                           (unsigned long long)st.hostCalls);
+        if (s_sdCost.enabled) snprintf(line + len, sizeof(line) - len, " %9.1f", st.simUs / 1000.0);
+        std::cout << line << std::endl;
+        simUs += st.simUs;
+    }
+    if (s_sdCost.enabled) {
+        char line[96];
+        snprintf(line, sizeof(line), "[SD] simulated card time %.1f ms", simUs / 1000.0);
+        std::cout << line << std::endl;
+    }
+}
+
 // ============================================================================
 // Adafruit_GFX Implementation
 // ============================================================================
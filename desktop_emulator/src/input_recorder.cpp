@@ -0,0 +1,179 @@
+/**
+ * @file input_recorder.cpp
+ * @brief Input session record / replay implementation
+ */
+
+#include "input_recorder.h"
+#include "desktop_display_sdl2.h"
+#include "pocketmage_compat.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static InputRecorder s_recorder;
+
+InputRecorder& inputRecorder() { return s_recorder; }
+
+static uint64_t fnv1a(const uint8_t* data, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static std::string toHex(const std::string& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (unsigned char c : bytes) {
+        out += digits[c >> 4];
+        out += digits[c & 0xF];
+    }
+    return out;
+}
+
+static std::string fromHex(const char* hex) {
+    std::string out;
+    for (size_t i = 0; hex[i] && hex[i + 1]; i += 2) {
+        unsigned int byte = 0;
+        if (sscanf(hex + i, "%2x", &byte) != 1) break;
+        out += (char)byte;
+    }
+    return out;
+}
+
+InputRecorder::~InputRecorder() {
+    if (_record) fclose(_record);
+    if (_frameLog && _frameLog != stdout) fclose(_frameLog);
+}
+
+bool InputRecorder::startRecording(const char* path) {
+    _record = fopen(path, "w");
+    if (!_record) return false;
+    fprintf(_record, "# PocketMage input trace: frame ms type data\n");
+    _startMs = millis();
+    std::cout << "[Recorder] Recording input to " << path << std::endl;
+    return true;
+}
+
+bool InputRecorder::startReplay(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        Event ev;
+        char data[1000] = "";
+        unsigned frame, ms;
+        if (sscanf(line, "%u %u %c %999s", &frame, &ms, &ev.type, data) < 3) continue;
+        ev.frame = frame;
+        ev.ms = ms;
+        if (ev.type == 'K' || ev.type == 'T') ev.data = fromHex(data);
+        else if (ev.type == 'S') ev.steps = atoi(data);
+        _events.push_back(ev);
+    }
+    fclose(f);
+
+    // Frames must be non-decreasing for beginFrame() to find them
+    std::stable_sort(_events.begin(), _events.end(),
+                     [](const Event& a, const Event& b) { return a.frame < b.frame; });
+    _replaying = true;
+    _startMs = millis();
+    std::cout << "[Recorder] Replaying " << _events.size() << " events from " << path << std::endl;
+    return true;
+}
+
+bool InputRecorder::openFrameLog(const char* path) {
+    _frameLog = path ? fopen(path, "w") : stdout;
+    if (!_frameLog) return false;
+    fprintf(_frameLog, "# frame ms eink oled loop_us eink_us\n");
+    return true;
+}
+
+void InputRecorder::writeEvent(char type, const std::string& data, int steps) {
+    _frameHadInput = true;
+    if (!_record) return;
+    const unsigned ms = (unsigned)(millis() - _startMs);
+    if (type == 'S') fprintf(_record, "%u %u S %d\n", _frame, ms, steps);
+    else if (type == 'Q') fprintf(_record, "%u %u Q\n", _frame, ms);
+    else fprintf(_record, "%u %u %c %s\n", _frame, ms, type, toHex(data).c_str());
+}
+
+void InputRecorder::onKey(char key)                   { writeEvent('K', std::string(1, key), 0); }
+void InputRecorder::onText(const std::string& text)   { writeEvent('T', text, 0); }
+void InputRecorder::onScroll(int steps)               { writeEvent('S', "", steps); }
+
+void InputRecorder::beginFrame(DesktopDisplay& display) {
+    if (!_replaying) return;
+
+    while (_next < _events.size() && _events[_next].frame <= _frame) {
+        const Event& ev = _events[_next];
+        // Keep firmware timers roughly where they were when recording
+        const uint32_t now = millis() - _startMs;
+        if (ev.ms > now) delay(ev.ms - now);
+
+        if (ev.type == 'Q') {
+            _next = _events.size();
+            break;
+        }
+        _next++;
+        if (ev.type == 'K' && !ev.data.empty()) display.injectKey(ev.data[0]);
+        else if (ev.type == 'T') display.injectText(ev.data);
+        else if (ev.type == 'S') display.injectScroll(ev.steps);
+    }
+}
+
+void InputRecorder::endFrame(const DesktopDisplay& display, uint32_t loopUs, uint32_t einkUs) {
+    _loopUs += loopUs;
+    _einkUs += einkUs;
+    _maxLoopUs = std::max(_maxLoopUs, loopUs);
+    _maxEinkUs = std::max(_maxEinkUs, einkUs);
+
+    if (_frameLog) {
+        const uint64_t einkHash = fnv1a(display.getEinkFramebuffer(), EINK_STRIDE * EINK_HEIGHT);
+        const uint64_t oledHash = fnv1a(display.getOledFramebuffer(), OLED_WIDTH * OLED_HEIGHT);
+        if (_frameHadInput || einkHash != _lastEinkHash || oledHash != _lastOledHash) {
+            fprintf(_frameLog, "%u %u %016llx %016llx %u %u\n", _frame, (unsigned)(millis() - _startMs),
+                    (unsigned long long)einkHash, (unsigned long long)oledHash, loopUs, einkUs);
+            _lastEinkHash = einkHash;
+            _lastOledHash = oledHash;
+            _loggedFrames++;
+        }
+    }
+
+    _frameHadInput = false;
+    _frame++;
+}
+
+// Done once the end marker is due, so replay runs exactly the recorded frames
+bool InputRecorder::replayDone() const {
+    if (!_replaying) return false;
+    if (_next >= _events.size()) return true;
+    const Event& ev = _events[_next];
+    return ev.type == 'Q' && ev.frame <= _frame;
+}
+
+void InputRecorder::finish() {
+    const bool active = _record || _replaying || _frameLog;
+    if (_record) {
+        writeEvent('Q', "", 0);
+        fclose(_record);
+        _record = nullptr;
+    }
+    if (_frameLog) {
+        fflush(_frameLog);
+        if (_frameLog != stdout) fclose(_frameLog);
+        _frameLog = nullptr;
+    }
+    if (!active || _frame == 0) return;
+
+    char buf[192];
+    snprintf(buf, sizeof(buf),
+             "[Recorder] %u frames (%u logged), loop() avg %lluus max %uus, e-ink handler avg %lluus max %uus",
+             _frame, _loggedFrames,
+             (unsigned long long)(_loopUs / _frame), _maxLoopUs,
+             (unsigned long long)(_einkUs / _frame), _maxEinkUs);
+    std::cout << buf << std::endl;
+}
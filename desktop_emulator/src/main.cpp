@@ -10,6 +10,11 @@
 #include "desktop_display_sdl2.h"
 #include "oled_service.h"
 #include "GxEPD2_BW.h"
+#include "SD_MMC.h"
+#include "eink_panel_model.h"
+#include "cpu_power_model.h"
+#include "input_recorder.h"
+#include <config.h>
 
 #include <iostream>
 #include <csignal>
@@ -41,6 +46,31 @@ static volatile bool s_running = true;
 static bool s_screenTestMode = false;
 static bool s_noFlash = false;  // Disable e-ink flash animation
 
+// Input record / replay (see input_recorder.h)
+static const char* s_recordPath = nullptr;
+static const char* s_replayPath = nullptr;
+static const char* s_frameLogPath = nullptr;
+static bool s_frameLog = false;
+
+// Panel / CPU model labels, in AppState order (globals.h)
+static const char* const APP_NAMES[] = {
+    "HOME", "TXT", "FILEWIZ", "USB", "BT", "SETTINGS", "TASKS", "CALENDAR", "JOURNAL",
+    "LEXICON", "APPLOADER", "HELLO", "ASTRALUA", "FLASHCARD", "GLUCOSE", "MUSIC",
+    "STARTER", "APPLAUNCHER"
+};
+static const int APP_NAME_COUNT = sizeof(APP_NAMES) / sizeof(APP_NAMES[0]);
+
+static void trackApp() {
+#ifndef _WIN32
+    // Declared as int here like below; MSVC mangles the enum type into the name
+    extern int CurrentAppState;
+    const int app = CurrentAppState;
+    const char* name = (app >= 0 && app < APP_NAME_COUNT) ? APP_NAMES[app] : "?";
+    einkPanel().setApp(app, name);
+    cpuPower().setApp(app, name);
+#endif
+}
+
 // Helper function to wait while keeping display responsive
 void testDelay(int ms) {
     int elapsed = 0;
@@ -175,12 +205,56 @@ int main(int argc, char* argv[]) {
         if (strcmp(argv[i], "--no-flash") == 0 || strcmp(argv[i], "-f") == 0) {
             s_noFlash = true;
         }
+        if (strncmp(argv[i], "--panel-timing=", 15) == 0) {
+            if (!einkPanel().parseTiming(argv[i] + 15)) {
+                std::cerr << "[Main] Bad --panel-timing, expected FULL,FAST,PARTIAL[,SPI_HZ]" << std::endl;
+                return 1;
+            }
+        }
+        if (strncmp(argv[i], "--cpu-power=", 12) == 0) {
+            if (!cpuPower().parseFigures(argv[i] + 12)) {
+                std::cerr << "[Main] Bad --cpu-power, expected BASE_MA,MA_PER_MHZ,IDLE_MA[,VOLTS]" << std::endl;
+                return 1;
+            }
+        }
+        if (strcmp(argv[i], "--sd-cost") == 0 || strncmp(argv[i], "--sd-cost=", 10) == 0) {
+            if (!SD_MMC.parseCostModel(argv[i][9] == '=' ? argv[i] + 10 : nullptr)) {
+                std::cerr << "[Main] Bad --sd-cost, expected LOOKUP_US,READ_US,WRITE_US,DIRENT_US" << std::endl;
+                return 1;
+            }
+        }
+        if (strcmp(argv[i], "--accelerated") == 0 || strcmp(argv[i], "-a") == 0) {
+            setClockAccelerated(true);
+        }
+        if (strncmp(argv[i], "--record=", 9) == 0) {
+            s_recordPath = argv[i] + 9;
+        }
+        if (strncmp(argv[i], "--replay=", 9) == 0) {
+            s_replayPath = argv[i] + 9;
+        }
+        if (strcmp(argv[i], "--frame-log") == 0 || strncmp(argv[i], "--frame-log=", 12) == 0) {
+            s_frameLog = true;
+            s_frameLogPath = argv[i][11] == '=' ? argv[i] + 12 : nullptr;
+        }
         if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             std::cout << "PocketMage PDA Desktop Emulator" << std::endl;
             std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
             std::cout << "Options:" << std::endl;
             std::cout << "  -t, --test      Run screen test mode" << std::endl;
             std::cout << "  -f, --no-flash  Disable e-ink flash animation" << std::endl;
+            std::cout << "  --panel-timing=FULL,FAST,PARTIAL[,SPI_HZ]" << std::endl;
+            std::cout << "                  Simulated e-ink refresh times in ms" << std::endl;
+            std::cout << "  --cpu-power=BASE_MA,MA_PER_MHZ,IDLE_MA[,VOLTS]" << std::endl;
+            std::cout << "                  CPU current figures for the energy estimate" << std::endl;
+            std::cout << "  --sd-cost[=LOOKUP_US,READ_US,WRITE_US,DIRENT_US]" << std::endl;
+            std::cout << "                  Charge simulated 1-bit SD_MMC card time" << std::endl;
+            std::cout << "  -a, --accelerated" << std::endl;
+            std::cout << "                  Virtual clock: sleeps and loop ticks pass instantly" << std::endl;
+            std::cout << "  --record=FILE   Record keys, text and wheel (touch slider) input" << std::endl;
+            std::cout << "  --replay=FILE   Replay a recorded session, then exit" << std::endl;
+            std::cout << "  --frame-log[=FILE]" << std::endl;
+            std::cout << "                  Log per-frame framebuffer hashes and handler timings" << std::endl;
+            std::cout << "                  (stdout by default)" << std::endl;
             std::cout << "  -h, --help      Show this help" << std::endl;
             return 0;
         }
@@ -250,21 +324,49 @@ int main(int argc, char* argv[]) {
         runScreenTest();
     }
     
+    // Start record / replay last so frame 0 is the first main loop pass
+    InputRecorder& recorder = inputRecorder();
+    if (s_recordPath && !recorder.startRecording(s_recordPath)) {
+        std::cerr << "[Main] Cannot write " << s_recordPath << std::endl;
+    }
+    if (s_replayPath) {
+        if (!recorder.startReplay(s_replayPath)) {
+            std::cerr << "[Main] Cannot read " << s_replayPath << std::endl;
+            s_running = false;
+        }
+        g_display->setLiveInputEnabled(false);
+    }
+    if ((s_frameLog || s_replayPath) && !recorder.openFrameLog(s_frameLogPath)) {
+        std::cerr << "[Main] Cannot write " << s_frameLogPath << std::endl;
+    }
+    
     std::cout << "[Main] Entering main loop..." << std::endl;
     
-    // Main loop
+    // Main loop. Like the device loop, it runs every LOOP_ACTIVE_MS for a
+    // while after input and every LOOP_IDLE_MS otherwise, and SDL events
+    // or wakeLoop() cut the wait short.
     int frameCount = 0;
+    unsigned long lastActivity = millis();
     while (s_running) {
         // Handle SDL events
         if (!g_display->handleEvents()) {
             break;
         }
         
+        // Replayed input for this frame
+        recorder.beginFrame(*g_display);
+        
         // Call PocketMage loop (processes keyboard, updates state)
+        trackApp();
+        const unsigned long loopStart = micros();
         loop();
         
         // Call the E-ink handler to render UI
+        trackApp();
+        const unsigned long einkStart = micros();
         applicationEinkHandler();
+        const unsigned long einkEnd = micros();
+        einkPanel().endFrame();
         
         // Present OLED updates
         oled_present_if_dirty();
@@ -272,19 +374,45 @@ int main(int argc, char* argv[]) {
         // Present display
         g_display->present();
         
+        recorder.endFrame(*g_display, (uint32_t)(einkStart - loopStart), (uint32_t)(einkEnd - einkStart));
+        if (recorder.replayDone()) {
+            break;
+        }
+        
         // Frame counter (for debugging)
         frameCount++;
         if (frameCount % 300 == 0) {
-            // Log every 10 seconds at 30 FPS
             std::cout << "[Main] Frame " << frameCount << std::endl;
         }
         
-        // Limit frame rate to ~60 FPS for responsive typing
-        delay(16);
+        // Replay runs frames back to back; its events carry their own timing
+        if (recorder.isReplaying()) {
+            continue;
+        }
+        
+        // Sleep until input, a wakeLoop(), or the next loop tick
+        const bool active = (millis() - lastActivity) < LOOP_ACTIVE_WINDOW_MS;
+        const uint32_t tickMs = active ? LOOP_ACTIVE_MS : LOOP_IDLE_MS;
+        bool woken;
+        if (isClockAccelerated()) {
+            // The tick passes in virtual time; input is still polled each frame
+            delay(tickMs);
+            woken = g_display->waitForEvent(0);
+        } else {
+            CpuIdleScope idle;
+            woken = g_display->waitForEvent(tickMs);
+        }
+        if (woken) {
+            lastActivity = millis();
+        }
     }
     
     // Cleanup
     std::cout << "[Main] Shutting down..." << std::endl;
+    recorder.finish();
+    SD_MMC.printStats();
+    einkPanel().printStats();
+    cpuPower().printStats();
     
     if (g_display) {
         g_display->shutdown();
@@ -86,10 +86,10 @@ void oled_present_if_dirty() {
         }
         
         s_dirty = false;
+        g_display->oledRefresh();
     }
     
-    // Always refresh to show any direct drawing
-    g_display->oledRefresh();
+    // Direct drawing is shown by U8G2::sendBuffer() -> oledRefresh()
 }
 
 const char* oled_get_line(int lineNum) {
@@ -13,6 +13,7 @@
 #include "oled_service.h"
 #include "GxEPD2_BW.h"
 #include "SD_MMC.h"
+#include "eink_panel_model.h"
 #include <fstream>
 #include "Wire.h"
 #include "SPI.h"
@@ -35,6 +36,7 @@
 // #include "MP2722.h"
 
 #include <iostream>
+#include <algorithm>
 
 // Constants
 #ifndef MAX_FILES
@@ -101,6 +103,8 @@ void GxEPD2_BW<GxEPD2_Type, page_height>::init(uint32_t serial_diag_bitrate, boo
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::setFullWindow() {
     _using_partial_mode = false;
+    _pw_w = GxEPD2_Type::WIDTH;
+    _pw_h = GxEPD2_Type::HEIGHT;
     // Clear screen to white when entering full window mode
     // This ensures clean transitions between apps
     if (g_display) {
@@ -111,6 +115,8 @@ void GxEPD2_BW<GxEPD2_Type, page_height>::setFullWindow() {
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
     _using_partial_mode = true;
+    _pw_w = w;
+    _pw_h = h;
 }
 
 template<typename GxEPD2_Type, int page_height>
@@ -124,8 +130,24 @@ bool GxEPD2_BW<GxEPD2_Type, page_height>::nextPage() {
     return false;
 }
 
+template<typename GxEPD2_Type, int page_height>
+void GxEPD2_BW<GxEPD2_Type, page_height>::accountRefresh(bool partial, int w, int h) {
+    EinkRefreshKind kind = EinkRefreshKind::PARTIAL;
+    if (!partial) {
+        kind = GxEPD2_Type::useFastFullUpdate ? EinkRefreshKind::FAST_FULL : EinkRefreshKind::FULL;
+    }
+    // Windows are given in rotated coordinates; the panel shifts native rows
+    if (_rotation & 1) std::swap(w, h);
+    einkPanel().refresh(kind, w, h);
+}
+
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::display(bool partial_update_mode) {
+    if (partial_update_mode && _using_partial_mode) {
+        accountRefresh(true, _pw_w, _pw_h);
+    } else {
+        accountRefresh(partial_update_mode, GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT);
+    }
     if (g_display) {
         if (partial_update_mode) {
             g_display->einkPartialRefresh();
@@ -137,6 +159,7 @@ void GxEPD2_BW<GxEPD2_Type, page_height>::display(bool partial_update_mode) {
 
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    accountRefresh(true, w, h);
     if (g_display) {
         g_display->einkPartialRefresh();
     }
@@ -180,32 +203,49 @@ void GxEPD2_BW<GxEPD2_Type, page_height>::drawPixel(int16_t x, int16_t y, uint16
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::fillScreen(uint16_t color) {
     if (g_display) {
-        if (color == GxEPD_WHITE) {
-            g_display->einkClear();
-        } else {
-            g_display->einkDrawRect(0, 0, EINK_WIDTH, EINK_HEIGHT, true, true);
-        }
+        g_display->einkFillScreen(color == GxEPD_BLACK);
     }
 }
 
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
     if (g_display) {
-        g_display->einkDrawLine(x, y, x, y + h - 1, color == GxEPD_BLACK);
+        g_display->einkFillRect(x, y, 1, h, color == GxEPD_BLACK);
     }
 }
 
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
     if (g_display) {
-        g_display->einkDrawLine(x, y, x + w - 1, y, color == GxEPD_BLACK);
+        g_display->einkFillRect(x, y, w, 1, color == GxEPD_BLACK);
     }
 }
 
 template<typename GxEPD2_Type, int page_height>
 void GxEPD2_BW<GxEPD2_Type, page_height>::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
     if (g_display) {
-        g_display->einkDrawRect(x, y, w, h, true, color == GxEPD_BLACK);
+        g_display->einkFillRect(x, y, w, h, color == GxEPD_BLACK);
+    }
+}
+
+template<typename GxEPD2_Type, int page_height>
+void GxEPD2_BW<GxEPD2_Type, page_height>::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                                      int16_t w, int16_t h, uint16_t color) {
+    if (g_display && bitmap) {
+        // If drawing a large bitmap at origin, clear screen first
+        // This handles apps like Journal that don't call fillScreen before drawing
+        if (x == 0 && y == 0 && w >= 300 && h >= 200) {
+            g_display->einkClear();
+        }
+        g_display->einkBlitBitmap(x, y, bitmap, w, h, color == GxEPD_BLACK);
+    }
+}
+
+template<typename GxEPD2_Type, int page_height>
+void GxEPD2_BW<GxEPD2_Type, page_height>::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                                                      int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+    if (g_display && bitmap) {
+        g_display->einkBlitBitmap(x, y, bitmap, w, h, color == GxEPD_BLACK, bg == GxEPD_BLACK ? 1 : 0);
     }
 }
 
@@ -596,12 +636,12 @@ void PocketMage_INIT() {
     
     // Create a sample file for testing
     {
-        std::ofstream testFile("./data/welcome.txt");
-        if (testFile.is_open()) {
-            testFile << "# Welcome to PocketMage!\n\n";
-            testFile << "This is the desktop emulator.\n\n";
-            testFile << "You can type here to test the text editor.\n\n";
-            testFile << "Press **Home** (key 12) to return to the main menu.\n";
+        File testFile = SD_MMC.open("/welcome.txt", FILE_WRITE);
+        if (testFile) {
+            testFile.print("# Welcome to PocketMage!\n\n");
+            testFile.print("This is the desktop emulator.\n\n");
+            testFile.print("You can type here to test the text editor.\n\n");
+            testFile.print("Press **Home** (key 12) to return to the main menu.\n");
             testFile.close();
             std::cout << "[Setup] Created welcome.txt" << std::endl;
         }
@@ -640,6 +680,11 @@ namespace pocketmage {
         void writeMetadata(const String& path) {
             std::cout << "[File] writeMetadata: " << path.c_str() << std::endl;
         }
+
+        void writeMetadata(const String& path, size_t fileSizeBytes, int charCount) {
+            std::cout << "[File] writeMetadata: " << path.c_str() << " (" << fileSizeBytes
+                      << " Bytes, " << charCount << " Char)" << std::endl;
+        }
         
         void loadFile(bool showOLED) {
             std::cout << "[File] loadFile()" << std::endl;
@@ -661,9 +706,86 @@ namespace pocketmage {
             std::cout << "[File] renMetadata" << std::endl;
         }
         
-        void copyFile(String oldFile, String newFile) {
-            String content = s_sdImpl.readFileToString(SD_MMC, oldFile.c_str());
-            s_sdImpl.writeFile(SD_MMC, newFile.c_str(), content.c_str());
+        // Bitwise CRC-32, stands in for esp_rom_crc32_le
+        static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t len) {
+            crc = ~crc;
+            for (size_t i = 0; i < len; i++) {
+                crc ^= data[i];
+                for (int b = 0; b < 8; b++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+            }
+            return ~crc;
+        }
+
+        // Same steps as the device: copy to a temp file, optionally verify
+        // it, then swap it in. A failure leaves the destination untouched.
+        bool copyFile(String oldFile, String newFile, bool verify,
+                      void (*progress)(size_t copied, size_t total)) {
+            if (!oldFile.startsWith("/")) oldFile = "/" + oldFile;
+            if (!newFile.startsWith("/")) newFile = "/" + newFile;
+            if (oldFile.equalsIgnoreCase(newFile)) {
+                std::cout << "[File] Copy onto itself: " << oldFile.c_str() << std::endl;
+                return false;
+            }
+
+            const String tmpFile = newFile + ".tmp";
+            File src = SD_MMC.open(oldFile.c_str(), "r");
+            File dst;
+            if (src && !src.isDirectory()) dst = SD_MMC.open(tmpFile.c_str(), "w");
+            const bool dstOpened = (bool)dst;
+            bool ok = dstOpened;
+
+            const size_t total = ok ? src.size() : 0;
+            size_t copied = 0;
+            int charCount = 0;
+            uint32_t crc = 0;
+            uint8_t buf[4096];
+            while (ok && copied < total) {
+                const size_t n = src.read(buf, sizeof(buf));
+                if (n == 0 || dst.write(buf, n) != n) {
+                    ok = false;
+                    break;
+                }
+                for (size_t i = 0; i < n; i++)
+                    if (buf[i] >= 32 && buf[i] <= 126) charCount++;
+                if (verify) crc = crc32(crc, buf, n);
+                copied += n;
+                if (progress) progress(copied, total);
+            }
+            if (src) src.close();
+            if (dst) dst.close();
+
+            if (ok && verify) {
+                File check = SD_MMC.open(tmpFile.c_str(), "r");
+                uint32_t checkCrc = 0;
+                size_t checked = 0;
+                while (check && check.available()) {
+                    const size_t n = check.read(buf, sizeof(buf));
+                    if (n == 0) break;
+                    checkCrc = crc32(checkCrc, buf, n);
+                    checked += n;
+                }
+                if (check) check.close();
+                ok = (checked == total && checkCrc == crc);
+            }
+
+            bool keepTmp = false;
+            if (ok) {
+                const bool replacing = SD_MMC.exists(newFile.c_str());
+                if (replacing && !SD_MMC.remove(newFile.c_str())) ok = false;
+                else if (!SD_MMC.rename(tmpFile.c_str(), newFile.c_str())) {
+                    ok = false;
+                    keepTmp = replacing;
+                }
+            }
+
+            if (ok) {
+                writeMetadata(newFile, total, charCount);
+            } else {
+                std::cout << "[File] Copy failed: " << oldFile.c_str() << " -> " << newFile.c_str() << std::endl;
+                if (dstOpened && !keepTmp && SD_MMC.exists(tmpFile.c_str()))
+                    SD_MMC.remove(tmpFile.c_str());
+            }
+            return ok;
         }
         
         void appendToFile(String path, String inText) {
@@ -694,6 +816,11 @@ namespace pocketmage {
             std::cout << "[Power] Power button interrupt" << std::endl;
         }
         
+        // The emulator main loop paces frames itself
+        void wakeLoop() { if (g_display) g_display->wake(); }
+        void waitForLoopWork() {}
+        void waitForEinkWork() {}
+
         void updateBattState() {
             // Battery state update - mock 75% battery
         }
@@ -6,9 +6,12 @@
 #include "pocketmage_stubs.h"
 #include "desktop_display_sdl2.h"
 #include "oled_service.h"
+#include "eink_panel_model.h"
+#include "GxEPD2_BW.h"
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include <algorithm>
 
 // External display pointer
 extern DesktopDisplay* g_display;
@@ -55,9 +58,8 @@ void PocketmageEink::drawStatusBar(const String& text) {
 }
 
 void PocketmageEink::einkTextDynamic(bool fullRefresh, bool showCursor) {
-    if (g_display) {
-        g_display->present();
-    }
+    // Only draws into the frame buffer on the device; the caller's next
+    // refresh() puts it on the panel
 }
 
 void PocketmageEink::forceSlowFullUpdate(bool force) {
@@ -68,6 +70,17 @@ void PocketmageEink::forceSlowFullUpdate(bool force) {
 }
 
 void PocketmageEink::multiPassRefresh(int passes) {
+    // Panel time: one full update, then a full-window partial per pass
+    // (windows in native portrait orientation)
+    EinkPanelModel& panel = einkPanel();
+    panel.refresh(GxEPD2_310_GDEQ031T10::useFastFullUpdate ? EinkRefreshKind::FAST_FULL : EinkRefreshKind::FULL,
+                  GxEPD2_310_GDEQ031T10::HEIGHT, GxEPD2_310_GDEQ031T10::WIDTH);
+    for (int i = 0; i < passes; i++) {
+        panel.hold(250);
+        panel.refresh(EinkRefreshKind::PARTIAL, GxEPD2_310_GDEQ031T10::HEIGHT, GxEPD2_310_GDEQ031T10::WIDTH);
+    }
+    panel.hold(100);
+    
     if (g_display) {
         // multiPassRefresh is used for full screen updates (like app transitions)
         // Do flash animation if enabled
@@ -77,6 +90,19 @@ void PocketmageEink::multiPassRefresh(int passes) {
 }
 
 void PocketmageEink::refresh() {
+    // Same schedule as the device: a slow full update every
+    // fullRefreshAfter_ fast ones, or when one was forced
+    if (partialCounter_ >= fullRefreshAfter_ || forceFullUpdate_) {
+        forceFullUpdate_ = false;
+        partialCounter_ = 0;
+        GxEPD2_310_GDEQ031T10::useFastFullUpdate = false;
+    } else {
+        GxEPD2_310_GDEQ031T10::useFastFullUpdate = true;
+        partialCounter_++;
+    }
+    einkPanel().refresh(GxEPD2_310_GDEQ031T10::useFastFullUpdate ? EinkRefreshKind::FAST_FULL : EinkRefreshKind::FULL,
+                        GxEPD2_310_GDEQ031T10::HEIGHT, GxEPD2_310_GDEQ031T10::WIDTH);
+    
     if (g_display) {
         g_display->einkRefresh();
         g_display->present();
@@ -102,6 +128,11 @@ void PocketmageOled::oledWord(String text, bool selected, bool highlight) {
     oled_set_line(1, text.c_str());
 }
 
+void PocketmageOled::sendBuffer() {
+    // The emulator redraws the whole OLED; no tile diffing needed
+    if (g_display) g_display->oledRefresh();
+}
+
 // ============================================================================
 // PocketmageKB implementations
 // ============================================================================
@@ -139,24 +170,21 @@ void PocketmageSD::listDir(fs::FS& fs, const char* dirname) {
     // Clear existing list
     filesListSize_ = 0;
     
-    // List files in the data directory
-    std::string basePath = "./data";
-    if (dirname && dirname[0] == '/') {
-        basePath += dirname;
+    // List files through the SD_MMC shim so the listing is cached and counted
+    File dir = fs.open(dirname ? dirname : "/");
+    if (!dir || !dir.isDirectory()) {
+        std::cout << "[SD] Error listing directory: " << (dirname ? dirname : "/") << std::endl;
+        return;
     }
     
-    try {
-        for (const auto& entry : std::filesystem::directory_iterator(basePath)) {
-            if (filesListSize_ >= 100) break;
-            
-            std::string filename = entry.path().filename().string();
-            // Store with leading slash for compatibility
-            filesList_[filesListSize_] = String(("/" + filename).c_str());
-            std::cout << "[SD] Found: " << filesList_[filesListSize_].c_str() << std::endl;
-            filesListSize_++;
-        }
-    } catch (const std::exception& e) {
-        std::cout << "[SD] Error listing directory: " << e.what() << std::endl;
+    while (filesListSize_ < 100) {
+        File entry = dir.openNextFile();
+        if (!entry) break;
+        
+        // Store with leading slash for compatibility
+        filesList_[filesListSize_] = "/" + entry.name();
+        std::cout << "[SD] Found: " << filesList_[filesListSize_].c_str() << std::endl;
+        filesListSize_++;
     }
 }
 
@@ -164,11 +192,26 @@ void PocketmageSD::listDir(fs::FS& fs, const char* dirname) {
 // PocketmageTOUCH implementations
 // ============================================================================
 bool PocketmageTOUCH::updateScroll(int maxScroll, unsigned long& lineScroll) {
-    return false;
+    // Mouse wheel steps stand in for the slider; reversed like the device
+    const int steps = g_display ? g_display->takeScrollSteps() : 0;
+    if (steps == 0) return false;
+    long next = (long)lineScroll - steps;
+    if (next > maxScroll) next = maxScroll;
+    if (next < 0) next = 0;
+    if ((unsigned long)next == lineScroll) return false;
+    lineScroll = (unsigned long)next;
+    return true;
 }
 
 void PocketmageTOUCH::updateScrollFromTouch() {
-    // Touch scroll - no-op in emulator
+    const int steps = g_display ? g_display->takeScrollSteps() : 0;
+    if (steps == 0) return;
+    const int maxScroll = std::max(0, (int)allLines.size() - 1);
+    const int next = std::min(std::max(dynamicScroll_ + steps, 0), maxScroll);
+    if (next != dynamicScroll_) {
+        dynamicScroll_ = next;
+        newLineAdded = true;
+    }
 }
 
 // ============================================================================